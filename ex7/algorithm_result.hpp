@@ -0,0 +1,62 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <variant>
+
+namespace graph {
+
+// Plain-text outcome that is not a computed value (empty or unsupported input)
+struct NoticeResult {
+    std::string message;
+};
+
+// Weight of a minimum spanning tree, or of a spanning forest when disconnected
+struct SpanningTreeResult {
+    long long weight;
+    bool connected;
+    int trees;  // Trees over the non-isolated vertices; 0 when only vertex 0's tree was weighed
+};
+
+// Strongly connected components as contiguous runs:
+// component i is members[offsets[i] .. offsets[i + 1])
+struct SCCResult {
+    std::vector<int> offsets;
+    std::vector<int> members;
+};
+
+// partial: the time budget ran out, so value is a feasible flow but not
+// necessarily a maximum one
+struct FlowResult {
+    int source;
+    int sink;
+    long long value;
+    bool partial = false;
+};
+
+// partial: the time budget ran out, so vertices is the largest clique found
+// so far rather than a maximum one
+struct CliqueResult {
+    std::vector<int> vertices;
+    bool partial = false;
+};
+
+// Typed result of a GraphAlgorithm. Algorithms build these without touching
+// strings; callers serialize once, when the response is assembled.
+using AlgorithmResult = std::variant<NoticeResult, SpanningTreeResult, SCCResult, FlowResult, CliqueResult>;
+
+// Whether a time budget cut the computation short
+bool isPartial(const AlgorithmResult& result);
+
+// Human-readable form, as the servers print it
+void appendText(std::string& out, const AlgorithmResult& result);
+std::string toText(const AlgorithmResult& result);
+
+// Compact little-endian form: a one-byte tag (the variant index, with the
+// high bit set for partial results) followed by fixed-width fields; vectors
+// are prefixed with their 32-bit length
+void appendBinary(std::string& out, const AlgorithmResult& result);
+std::string toBinary(const AlgorithmResult& result);
+// Inverse of toBinary; throws std::invalid_argument on malformed input
+AlgorithmResult fromBinary(const std::string& bytes);
+
+} // namespace graph
@@ -0,0 +1,93 @@
+#pragma once
+#include "graph.hpp"
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+
+namespace graph {
+
+// Immutable compressed sparse row (CSR) snapshot of a graph.
+// The neighbors of vertex v occupy [offsets[v], offsets[v + 1]) of the
+// contiguous dests/weights arrays, in the same order Graph::getNeighbors(v)
+// walks them, so algorithms see identical traversal orders on both stores.
+class CSRGraph {
+public:
+    struct Edge {
+        int dest;
+        int weight;
+    };
+
+    class NeighborIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Edge;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Edge*;
+        using reference = Edge;
+
+        NeighborIterator(const int* d, const int* w) : dest(d), weight(w) {}
+        Edge operator*() const { return Edge{*dest, *weight}; }
+        NeighborIterator& operator++() { ++dest; ++weight; return *this; }
+        NeighborIterator operator++(int) { NeighborIterator tmp = *this; ++*this; return tmp; }
+        bool operator==(const NeighborIterator& other) const { return dest == other.dest; }
+        bool operator!=(const NeighborIterator& other) const { return dest != other.dest; }
+
+    private:
+        const int* dest;
+        const int* weight;
+    };
+
+    class NeighborRange {
+    public:
+        NeighborRange(const int* d, const int* w, int count) : dest(d), weight(w), count(count) {}
+        NeighborIterator begin() const { return NeighborIterator(dest, weight); }
+        NeighborIterator end() const { return NeighborIterator(dest + count, weight + count); }
+        int size() const { return count; }
+        bool empty() const { return count == 0; }
+
+    private:
+        const int* dest;
+        const int* weight;
+        int count;
+    };
+
+    explicit CSRGraph(const Graph& graph);
+
+    // Build from an edge list as Graph::addEdge would have stored it
+    static CSRGraph fromEdges(int vertices, const std::vector<std::pair<int, int>>& edges, int weight = 1,
+                              bool directed = false);
+    // Same graph as Graph::generateRandomGraph, without building linked lists
+    static CSRGraph generateRandomGraph(int vertices, int edges, unsigned int seed, unsigned int threads = 1,
+                                        bool directed = false);
+
+    int getNumVertices() const;
+    int getNumEdges() const;
+    bool isDirected() const { return directed; }
+    int getDegree(int vertex) const;
+    NeighborRange neighbors(int vertex) const;
+    bool hasEdge(int src, int dest) const;
+    int getEdgeWeight(int src, int dest) const;
+    // In-edge view of a directed graph (u -> v becomes v -> u)
+    CSRGraph transposed() const;
+    // Undirected graph with an edge wherever either direction has one
+    CSRGraph symmetrized() const;
+    // Component label of every vertex (its smallest member); weak components when directed
+    std::vector<int> connectedComponents(unsigned int threads = 1) const;
+
+    // Raw arrays for algorithms that index half-edges directly
+    const std::vector<int>& getOffsets() const { return offsets; }
+    const std::vector<int>& getDests() const { return dests; }
+    const std::vector<int>& getWeights() const { return weights; }
+
+private:
+    CSRGraph(int n, bool directed);
+
+    int numVertices;
+    bool directed;
+    std::vector<int> offsets;
+    std::vector<int> dests;
+    std::vector<int> weights;
+};
+
+} // namespace graph
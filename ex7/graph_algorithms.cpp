@@ -1,336 +1,1495 @@
 #include "graph_algorithm.hpp"
+#include "work_stealing_pool.hpp"
 #include <vector>
-#include <queue>
 #include <set>
 #include <algorithm>
 #include <climits>
-#include <sstream>
+#include <cstdint>
+#include <atomic>
+#include <stdexcept>
 
 namespace graph {
 
-// MST Weight Algorithm Implementation
-class MSTWeightAlgorithm : public GraphAlgorithm {
+// Indexed d-ary min-heap over items 0..n-1 with decrease-key.
+// pos maps each item to its heap slot, so an item is held at most once
+// and the heap never grows beyond n entries. A 4-ary layout halves the
+// depth of a binary heap and keeps a node's children in one cache line.
+// Storage is borrowed from a workspace and pos is epoch-stamped, so a new
+// heap costs nothing for items it never sees.
+template <typename Key, int Arity = 4>
+class IndexedHeap {
 public:
-    std::string execute(const Graph& graph) override {
+    IndexedHeap(int n, Workspace& workspace)
+        : keys(workspace.borrow<std::vector<Key>>()), pos(workspace.borrow<StampedArray<int>>()),
+          heap(workspace.borrow<std::vector<int>>()) {
+        keys->resize(n);
+        pos->reset(n, -1);
+        heap->clear();
+        heap->reserve(n);
+    }
+    
+    bool empty() const { return heap->empty(); }
+    int size() const { return static_cast<int>(heap->size()); }
+    bool contains(int item) const { return pos->get(item) >= 0; }
+    int top() const { return heap->front(); }
+    const Key& topKey() const { return (*keys)[heap->front()]; }
+    
+    void push(int item, const Key& key) {
+        (*keys)[item] = key;
+        heap->push_back(item);
+        siftUp(size() - 1);
+    }
+    
+    void decreaseKey(int item, const Key& key) {
+        (*keys)[item] = key;
+        siftUp(pos->get(item));
+    }
+    
+    // Insert item, or lower its key if key is smaller; true if anything changed
+    bool pushOrDecrease(int item, const Key& key) {
+        if (!contains(item)) {
+            push(item, key);
+            return true;
+        }
+        if (key < (*keys)[item]) {
+            decreaseKey(item, key);
+            return true;
+        }
+        return false;
+    }
+    
+    // Remove and return the item with the smallest key
+    int pop() {
+        std::vector<int>& h = *heap;
+        int item = h.front();
+        pos->set(item, -1);
+        int last = h.back();
+        h.pop_back();
+        if (!h.empty()) {
+            h[0] = last;
+            siftDown(0);
+        }
+        return item;
+    }
+    
+private:
+    void siftUp(int slot) {
+        std::vector<int>& h = *heap;
+        const std::vector<Key>& k = *keys;
+        int item = h[slot];
+        while (slot > 0) {
+            int parent = (slot - 1) / Arity;
+            if (!(k[item] < k[h[parent]])) {
+                break;
+            }
+            h[slot] = h[parent];
+            pos->set(h[slot], slot);
+            slot = parent;
+        }
+        h[slot] = item;
+        pos->set(item, slot);
+    }
+    
+    void siftDown(int slot) {
+        std::vector<int>& h = *heap;
+        const std::vector<Key>& k = *keys;
+        int item = h[slot];
+        int count = size();
+        while (true) {
+            int first = slot * Arity + 1;
+            if (first >= count) {
+                break;
+            }
+            int best = first;
+            int last = std::min(first + Arity, count);
+            for (int child = first + 1; child < last; child++) {
+                if (k[h[child]] < k[h[best]]) {
+                    best = child;
+                }
+            }
+            if (!(k[h[best]] < k[item])) {
+                break;
+            }
+            h[slot] = h[best];
+            pos->set(h[slot], slot);
+            slot = best;
+        }
+        h[slot] = item;
+        pos->set(item, slot);
+    }
+    
+    Workspace::Lease<std::vector<Key>> keys;
+    Workspace::Lease<StampedArray<int>> pos;    // Heap slot of each item, -1 when absent
+    Workspace::Lease<std::vector<int>> heap;    // Items in heap order
+};
+
+// MST Weight Algorithm Implementation (Prim over an indexed 4-ary heap)
+class MSTWeightAlgorithm final : public GraphAlgorithm {
+public:
+    AlgorithmResult compute(const CSRGraph& graph, Workspace& workspace, const CancellationToken&) override {
         int n = graph.getNumVertices();
-        if (n == 0) return "Graph is empty";
+        if (n == 0) return NoticeResult{"Graph is empty"};
+        if (graph.isDirected()) return NoticeResult{"MST requires an undirected graph"};
         
-        // Prim's algorithm for MST
-        std::vector<bool> visited(n, false);
-        std::vector<int> key(n, INT_MAX);
-        std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, 
-                           std::greater<std::pair<int, int>>> pq;
+        // Prim's algorithm for MST; each vertex sits in the heap at most
+        // once, keyed by its lightest edge into the tree
+        auto visited = workspace.borrow<StampedSet>();
+        visited->reset(n);
+        IndexedHeap<int> heap(n, workspace);
         
-        int mstWeight = 0;
+        long long mstWeight = 0;
         int startVertex = 0;
         
-        key[startVertex] = 0;
-        pq.push({0, startVertex});
+        heap.push(startVertex, 0);
         
-        while (!pq.empty()) {
-            int u = pq.top().second;
-            int weight = pq.top().first;
-            pq.pop();
-            
-            if (visited[u]) continue;
+        while (!heap.empty()) {
+            int weight = heap.topKey();
+            int u = heap.pop();
             
-            visited[u] = true;
+            visited->insert(u);
             mstWeight += weight;
             
-            Neighbor* current = graph.getNeighbors(u);
-            while (current != nullptr) {
-                int v = current->dest;
-                int w = current->weight;
-                
-                if (!visited[v] && w < key[v]) {
-                    key[v] = w;
-                    pq.push({w, v});
+            for (const auto& edge : graph.neighbors(u)) {
+                if (!visited->contains(edge.dest)) {
+                    heap.pushOrDecrease(edge.dest, edge.weight);
                 }
-                current = current->next;
             }
         }
         
         // Check if MST covers all vertices
         for (int i = 0; i < n; i++) {
-            if (graph.getDegree(i) > 0 && !visited[i]) {
-                return "Graph is not connected - MST weight: " + std::to_string(mstWeight);
+            if (graph.getDegree(i) > 0 && !visited->contains(i)) {
+                return SpanningTreeResult{mstWeight, false, 0};
             }
         }
         
-        return "MST Weight: " + std::to_string(mstWeight);
+        return SpanningTreeResult{mstWeight, true, 1};
     }
     
     std::string getName() const override {
-        return "MST Weight";
+        return AlgorithmFactory::info(AlgorithmFactory::AlgorithmType::MST_WEIGHT).title;
+    }
+};
+
+// Undirected edge listed once, from its smaller endpoint
+struct WeightedEdge {
+    int u;
+    int v;
+    int weight;
+};
+
+// Every undirected edge of the graph exactly once (u < v)
+static void undirectedEdges(const CSRGraph& graph, std::vector<WeightedEdge>& edges) {
+    edges.clear();
+    edges.reserve(graph.getNumEdges());
+    for (int u = 0; u < graph.getNumVertices(); u++) {
+        for (const auto& edge : graph.neighbors(u)) {
+            if (u < edge.dest) {
+                edges.push_back({u, edge.dest, edge.weight});
+            }
+        }
+    }
+}
+
+// Count the trees of a spanning forest. Isolated vertices do not count as
+// separate trees, matching Prim's connectivity check.
+static SpanningTreeResult spanningForestResult(const CSRGraph& graph, long long weight, int forestEdges) {
+    int touched = 0;
+    for (int v = 0; v < graph.getNumVertices(); v++) {
+        if (graph.getDegree(v) > 0) {
+            touched++;
+        }
+    }
+    int trees = touched - forestEdges;
+    return SpanningTreeResult{weight, trees <= 1, trees};
+}
+
+// Union-find with union by size and path halving
+struct DisjointSets {
+    std::vector<int> parent;
+    std::vector<int> size;
+    
+    // n singletons, reusing the arrays of an earlier use
+    void reset(int n) {
+        parent.resize(n);
+        size.assign(n, 1);
+        for (int i = 0; i < n; i++) {
+            parent[i] = i;
+        }
+    }
+    
+    int find(int v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+    
+    // Merge the sets of a and b; false if they were already one set
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return false;
+        }
+        if (size[a] < size[b]) {
+            std::swap(a, b);
+        }
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
     }
 };
 
-// Strongly Connected Components Algorithm Implementation
-class SCCAlgorithm : public GraphAlgorithm {
+// Minimum spanning forest with Kruskal: LSD radix sort on weight, then a
+// union-find sweep that stops once the forest is complete
+class KruskalMSTAlgorithm final : public GraphAlgorithm {
 private:
-    void dfs1(const Graph& graph, int v, std::vector<bool>& visited, std::vector<int>& order) {
-        visited[v] = true;
-        Neighbor* current = graph.getNeighbors(v);
-        while (current != nullptr) {
-            if (!visited[current->dest]) {
-                dfs1(graph, current->dest, visited, order);
+    // Stable sort by signed weight, 8 bits per pass. A pass where every key
+    // has the same byte is skipped, so unit weights are not moved at all.
+    void sortByWeight(std::vector<WeightedEdge>& edges, std::vector<WeightedEdge>& buffer) {
+        buffer.resize(edges.size());
+        for (int shift = 0; shift < 32; shift += 8) {
+            size_t count[257] = {0};
+            for (const auto& edge : edges) {
+                uint32_t key = static_cast<uint32_t>(edge.weight) ^ 0x80000000u;
+                count[((key >> shift) & 0xFF) + 1]++;
+            }
+            bool trivial = false;
+            for (int b = 1; b <= 256; b++) {
+                if (count[b] == edges.size()) {
+                    trivial = true;
+                    break;
+                }
+            }
+            if (trivial) {
+                continue;
             }
-            current = current->next;
+            for (int b = 0; b < 256; b++) {
+                count[b + 1] += count[b];
+            }
+            for (const auto& edge : edges) {
+                uint32_t key = static_cast<uint32_t>(edge.weight) ^ 0x80000000u;
+                buffer[count[(key >> shift) & 0xFF]++] = edge;
+            }
+            edges.swap(buffer);
         }
-        order.push_back(v);
     }
     
-    void dfs2(const Graph& graph, int v, std::vector<bool>& visited, std::vector<int>& component) {
-        visited[v] = true;
-        component.push_back(v);
-        Neighbor* current = graph.getNeighbors(v);
-        while (current != nullptr) {
-            if (!visited[current->dest]) {
-                dfs2(graph, current->dest, visited, component);
+public:
+    AlgorithmResult compute(const CSRGraph& graph, Workspace& workspace, const CancellationToken&) override {
+        int n = graph.getNumVertices();
+        if (n == 0) return NoticeResult{"Graph is empty"};
+        if (graph.isDirected()) return NoticeResult{"MST requires an undirected graph"};
+        
+        auto edges = workspace.borrow<std::vector<WeightedEdge>>();
+        auto buffer = workspace.borrow<std::vector<WeightedEdge>>();
+        undirectedEdges(graph, *edges);
+        sortByWeight(*edges, *buffer);
+        
+        auto sets = workspace.borrow<DisjointSets>();
+        sets->reset(n);
+        long long weight = 0;
+        int forestEdges = 0;
+        for (const auto& edge : *edges) {
+            if (sets->unite(edge.u, edge.v)) {
+                weight += edge.weight;
+                if (++forestEdges == n - 1) {
+                    break;
+                }
             }
-            current = current->next;
+        }
+        return spanningForestResult(graph, weight, forestEdges);
+    }
+    
+    std::string getName() const override {
+        return AlgorithmFactory::info(AlgorithmFactory::AlgorithmType::MST_KRUSKAL).title;
+    }
+};
+
+// Minimum spanning forest with Borůvka rounds. Each round every component
+// picks its lightest outgoing edge (ties broken by edge index, so choices
+// never form a cycle) and all picks are merged; components at least halve.
+// Edge scans and filtering run on the work-stealing pool, whose helper
+// threads outlive the request, so a phase costs no thread start-up; a phase
+// with at most EDGES_PER_TASK live edges is a single task and stays on the
+// calling thread.
+class BoruvkaMSTAlgorithm final : public GraphAlgorithm {
+private:
+    static constexpr size_t EDGES_PER_TASK = 1 << 15;
+    static constexpr uint64_t NO_EDGE = ~uint64_t(0);
+    
+    unsigned int threads;
+    
+    // Order edges by weight, then index, in one comparable word
+    static uint64_t edgeKey(int weight, size_t index) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(weight) ^ 0x80000000u) << 32) | index;
+    }
+    
+    static void lowerTo(std::atomic<uint64_t>& slot, uint64_t key) {
+        uint64_t current = slot.load(std::memory_order_relaxed);
+        while (key < current && !slot.compare_exchange_weak(current, key, std::memory_order_relaxed)) {
         }
     }
     
 public:
-    std::string execute(const Graph& graph) override {
+    explicit BoruvkaMSTAlgorithm(unsigned int threads) : threads(threads) {}
+    
+    AlgorithmResult compute(const CSRGraph& graph, Workspace& workspace, const CancellationToken&) override {
         int n = graph.getNumVertices();
-        if (n == 0) return "Graph is empty";
+        if (n == 0) return NoticeResult{"Graph is empty"};
+        if (graph.isDirected()) return NoticeResult{"MST requires an undirected graph"};
+        
+        auto edgeLease = workspace.borrow<std::vector<WeightedEdge>>();
+        std::vector<WeightedEdge>& edges = *edgeLease;
+        undirectedEdges(graph, edges);
+        if (edges.size() >= (size_t(1) << 32)) {
+            throw std::invalid_argument("Too many edges for Boruvka edge keys");
+        }
+        WorkStealingPool pool(threads);
+        auto setsLease = workspace.borrow<DisjointSets>();
+        DisjointSets& sets = *setsLease;
+        sets.reset(n);
+        auto componentLease = workspace.borrow<std::vector<int>>();
+        std::vector<int>& component = *componentLease;
+        component.resize(n);
+        for (int v = 0; v < n; v++) {
+            component[v] = v;
+        }
+        std::vector<std::atomic<uint64_t>> lightest(n);
+        for (auto& slot : lightest) {
+            slot.store(NO_EDGE, std::memory_order_relaxed);
+        }
         
-        std::vector<bool> visited(n, false);
-        std::vector<int> order;
+        // Indices of edges that still cross components
+        auto liveLease = workspace.borrow<std::vector<uint32_t>>();
+        std::vector<uint32_t>& live = *liveLease;
+        live.resize(edges.size());
+        for (size_t i = 0; i < live.size(); i++) {
+            live[i] = static_cast<uint32_t>(i);
+        }
+        auto keptLease = workspace.borrow<std::vector<std::vector<uint32_t>>>();
+        std::vector<std::vector<uint32_t>>& kept = *keptLease;
+        long long weight = 0;
+        int forestEdges = 0;
         
-        // First DFS to get topological order
-        for (int i = 0; i < n; i++) {
-            if (!visited[i]) {
-                dfs1(graph, i, visited, order);
+        while (!live.empty()) {
+            size_t tasks = (live.size() + EDGES_PER_TASK - 1) / EDGES_PER_TASK;
+            
+            // Lightest edge leaving each component
+            pool.run(tasks, [&](size_t task, unsigned int) {
+                size_t end = std::min(live.size(), (task + 1) * EDGES_PER_TASK);
+                for (size_t i = task * EDGES_PER_TASK; i < end; i++) {
+                    const WeightedEdge& edge = edges[live[i]];
+                    uint64_t key = edgeKey(edge.weight, live[i]);
+                    lowerTo(lightest[component[edge.u]], key);
+                    lowerTo(lightest[component[edge.v]], key);
+                }
+            });
+            
+            // Merge along every pick; an edge picked by both sides merges once
+            for (int c = 0; c < n; c++) {
+                uint64_t key = lightest[c].load(std::memory_order_relaxed);
+                if (key == NO_EDGE) {
+                    continue;
+                }
+                lightest[c].store(NO_EDGE, std::memory_order_relaxed);
+                const WeightedEdge& pick = edges[key & 0xFFFFFFFFu];
+                if (sets.unite(pick.u, pick.v)) {
+                    weight += pick.weight;
+                    forestEdges++;
+                }
+            }
+            for (int v = 0; v < n; v++) {
+                component[v] = sets.find(v);
+            }
+            
+            // Keep only edges that still cross components
+            if (kept.size() < tasks) {
+                kept.resize(tasks);
+            }
+            for (size_t task = 0; task < tasks; task++) {
+                kept[task].clear();
+            }
+            pool.run(tasks, [&](size_t task, unsigned int) {
+                size_t end = std::min(live.size(), (task + 1) * EDGES_PER_TASK);
+                for (size_t i = task * EDGES_PER_TASK; i < end; i++) {
+                    const WeightedEdge& edge = edges[live[i]];
+                    if (component[edge.u] != component[edge.v]) {
+                        kept[task].push_back(live[i]);
+                    }
+                }
+            });
+            live.clear();
+            for (size_t task = 0; task < tasks; task++) {
+                live.insert(live.end(), kept[task].begin(), kept[task].end());
             }
         }
+        return spanningForestResult(graph, weight, forestEdges);
+    }
+    
+    std::string getName() const override {
+        return AlgorithmFactory::info(AlgorithmFactory::AlgorithmType::MST_BORUVKA).title;
+    }
+};
+
+// Strongly Connected Components Algorithm Implementation (iterative Tarjan)
+// One DFS over the out-edges with an explicit call stack: no recursion and
+// no transpose graph. Components come out in the order Tarjan completes
+// them (every component after all components it can reach), each listed
+// from its DFS root in discovery order.
+class SCCAlgorithm final : public GraphAlgorithm {
+private:
+    // Component k is members[offsets[k] .. offsets[k + 1])
+    void tarjan(const CSRGraph& graph, Workspace& workspace, std::vector<int>& offsets, std::vector<int>& members) {
+        int n = graph.getNumVertices();
+        const std::vector<int>& edgeStart = graph.getOffsets();
+        const std::vector<int>& dests = graph.getDests();
         
-        // Create transpose graph
-        Graph transpose(n);
-        for (int i = 0; i < n; i++) {
-            Neighbor* current = graph.getNeighbors(i);
-            while (current != nullptr) {
-                transpose.addEdge(current->dest, i, current->weight);
-                current = current->next;
+        // Every vertex is visited, so plain arrays refilled per call beat stamps here
+        auto indexLease = workspace.borrow<std::vector<int>>();
+        auto lowLease = workspace.borrow<std::vector<int>>();
+        auto cursorLease = workspace.borrow<std::vector<int>>();
+        auto assignedLease = workspace.borrow<std::vector<bool>>();
+        auto stackLease = workspace.borrow<std::vector<int>>();
+        auto callStackLease = workspace.borrow<std::vector<int>>();
+        std::vector<int>& index = *indexLease;
+        std::vector<int>& low = *lowLease;
+        std::vector<int>& cursor = *cursorLease;           // Next out-edge to scan
+        std::vector<bool>& assigned = *assignedLease;
+        std::vector<int>& stack = *stackLease;             // Visited vertices not yet in a component
+        std::vector<int>& callStack = *callStackLease;
+        index.assign(n, -1);
+        low.resize(n);
+        cursor.resize(n);
+        assigned.assign(n, false);
+        stack.clear();
+        callStack.clear();
+        int counter = 0;
+        
+        offsets.assign(1, 0);
+        members.clear();
+        members.reserve(n);
+        
+        auto visit = [&](int v) {
+            index[v] = low[v] = counter++;
+            cursor[v] = edgeStart[v];
+            stack.push_back(v);
+            callStack.push_back(v);
+        };
+        
+        for (int root = 0; root < n; root++) {
+            if (index[root] != -1) {
+                continue;
+            }
+            visit(root);
+            while (!callStack.empty()) {
+                int v = callStack.back();
+                if (cursor[v] < edgeStart[v + 1]) {
+                    int w = dests[cursor[v]++];
+                    if (index[w] == -1) {
+                        visit(w);
+                    } else if (!assigned[w]) {
+                        low[v] = std::min(low[v], index[w]);
+                    }
+                    continue;
+                }
+                
+                // All edges of v done: return to the caller
+                callStack.pop_back();
+                if (!callStack.empty()) {
+                    int parent = callStack.back();
+                    low[parent] = std::min(low[parent], low[v]);
+                }
+                if (low[v] == index[v]) {
+                    // v roots a component: everything above it on the stack
+                    size_t start = stack.size();
+                    do {
+                        start--;
+                    } while (stack[start] != v);
+                    for (size_t i = start; i < stack.size(); i++) {
+                        assigned[stack[i]] = true;
+                        members.push_back(stack[i]);
+                    }
+                    stack.resize(start);
+                    offsets.push_back(static_cast<int>(members.size()));
+                }
+            }
+        }
+    }
+    
+public:
+    AlgorithmResult compute(const CSRGraph& graph, Workspace& workspace, const CancellationToken&) override {
+        int n = graph.getNumVertices();
+        if (n == 0) return NoticeResult{"Graph is empty"};
+        
+        // Offsets are collected in scratch space and copied out at their
+        // final size; members always hold exactly n vertices
+        auto offsets = workspace.borrow<std::vector<int>>();
+        SCCResult result;
+        tarjan(graph, workspace, *offsets, result.members);
+        result.offsets.assign(offsets->begin(), offsets->end());
+        return result;
+    }
+    
+    std::string getName() const override {
+        return AlgorithmFactory::info(AlgorithmFactory::AlgorithmType::SCC).title;
+    }
+};
+
+// Residual network as flat arc arrays grouped by tail vertex.
+// Every graph half-edge u -> v becomes a forward arc with capacity = weight
+// plus a zero-capacity reverse arc; rev[] links each arc to its partner.
+struct FlowNetwork {
+    int n = 0;
+    std::vector<int> head;   // Arcs of u are [head[u], head[u + 1])
+    std::vector<int> to;
+    std::vector<int> rev;
+    std::vector<long long> cap;
+    std::vector<int> fill;   // Build cursor per vertex
+    
+    // Rebuild for graph, reusing the arrays of an earlier network. On large
+    // graphs the scattered reverse arcs make this a sizeable share of a run,
+    // so it polls too; false if the poller fired and the network is unusable.
+    bool build(const CSRGraph& graph, CancellationPoller& poller) {
+        n = graph.getNumVertices();
+        head.assign(n + 1, 0);
+        for (int u = 0; u < n; u++) {
+            if (poller.poll()) {
+                return false;
+            }
+            for (const auto& edge : graph.neighbors(u)) {
+                if (edge.weight > 0) {
+                    head[u + 1]++;
+                    head[edge.dest + 1]++;
+                }
             }
         }
+        for (int u = 0; u < n; u++) {
+            head[u + 1] += head[u];
+        }
         
-        // Second DFS on transpose graph
-        std::fill(visited.begin(), visited.end(), false);
-        std::vector<std::vector<int>> sccs;
+        to.resize(head[n]);
+        rev.resize(head[n]);
+        cap.resize(head[n]);
+        fill.assign(head.begin(), head.end() - 1);
+        for (int u = 0; u < n; u++) {
+            if (poller.poll()) {
+                return false;
+            }
+            for (const auto& edge : graph.neighbors(u)) {
+                if (edge.weight > 0) {
+                    int forward = fill[u]++;
+                    int backward = fill[edge.dest]++;
+                    to[forward] = edge.dest;
+                    cap[forward] = edge.weight;
+                    rev[forward] = backward;
+                    to[backward] = u;
+                    cap[backward] = 0;
+                    rev[backward] = forward;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+// Max Flow Algorithm Implementation (Dinic)
+class MaxFlowAlgorithm final : public GraphAlgorithm {
+private:
+    // Build BFS levels over arcs with residual capacity; false once the
+    // sink is unreachable or the poller fires
+    bool bfs(const FlowNetwork& net, int source, int sink, std::vector<int>& level, std::vector<int>& queue,
+             CancellationPoller& poller) {
+        std::fill(level.begin(), level.end(), -1);
+        queue.clear();
+        queue.push_back(source);
+        level[source] = 0;
         
-        for (int i = order.size() - 1; i >= 0; i--) {
-            int v = order[i];
-            if (!visited[v]) {
-                std::vector<int> component;
-                dfs2(transpose, v, visited, component);
-                sccs.push_back(component);
+        for (size_t front = 0; front < queue.size(); front++) {
+            if (poller.poll()) {
+                return false;
+            }
+            int u = queue[front];
+            for (int e = net.head[u]; e < net.head[u + 1]; e++) {
+                int v = net.to[e];
+                if (level[v] < 0 && net.cap[e] > 0) {
+                    level[v] = level[u] + 1;
+                    queue.push_back(v);
+                }
             }
         }
+        return level[sink] >= 0;
+    }
+    
+    // Saturate the level graph with an iterative DFS; it[] remembers the
+    // next arc to try per vertex so each arc is skipped at most once a phase.
+    // Stops early when the poller fires; every path counted so far is complete.
+    long long blockingFlow(FlowNetwork& net, int source, int sink, std::vector<int>& level, std::vector<int>& it,
+                           std::vector<int>& path, CancellationPoller& poller) {
+        long long total = 0;
+        path.clear();
+        int u = source;
         
-        std::stringstream result;
-        result << "Found " << sccs.size() << " Strongly Connected Components:\n";
-        for (size_t i = 0; i < sccs.size(); i++) {
-            result << "SCC " << (i + 1) << ": {";
-            for (size_t j = 0; j < sccs[i].size(); j++) {
-                if (j > 0) result << ", ";
-                result << sccs[i][j];
+        while (!poller.poll()) {
+            if (u == sink) {
+                long long pathFlow = LLONG_MAX;
+                for (int e : path) {
+                    pathFlow = std::min(pathFlow, net.cap[e]);
+                }
+                size_t firstSaturated = path.size();
+                for (size_t i = 0; i < path.size(); i++) {
+                    int e = path[i];
+                    net.cap[e] -= pathFlow;
+                    net.cap[net.rev[e]] += pathFlow;
+                    if (net.cap[e] == 0 && firstSaturated == path.size()) {
+                        firstSaturated = i;
+                    }
+                }
+                total += pathFlow;
+                // Retreat to the tail of the first saturated arc
+                path.resize(firstSaturated);
+                u = path.empty() ? source : net.to[path.back()];
+                continue;
+            }
+            
+            int& e = it[u];
+            while (e < net.head[u + 1] && (net.cap[e] == 0 || level[net.to[e]] != level[u] + 1)) {
+                e++;
             }
-            result << "}\n";
+            if (e < net.head[u + 1]) {
+                path.push_back(e);
+                u = net.to[e];
+            } else {
+                // Dead end: drop u from the level graph and back up
+                if (u == source) {
+                    break;
+                }
+                level[u] = -1;
+                path.pop_back();
+                u = path.empty() ? source : net.to[path.back()];
+            }
+        }
+        return total;
+    }
+    
+public:
+    AlgorithmResult compute(const CSRGraph& graph, Workspace& workspace, const CancellationToken& cancel) override {
+        int n = graph.getNumVertices();
+        if (n < 2) return NoticeResult{"Graph needs at least 2 vertices for max flow"};
+        
+        int source = 0;
+        int sink = n - 1;
+        
+        auto network = workspace.borrow<FlowNetwork>();
+        auto level = workspace.borrow<std::vector<int>>();
+        auto it = workspace.borrow<std::vector<int>>();
+        auto queue = workspace.borrow<std::vector<int>>();
+        auto path = workspace.borrow<std::vector<int>>();
+        CancellationPoller poller(cancel);
+        FlowNetwork& net = *network;
+        if (!net.build(graph, poller)) {
+            return FlowResult{source, sink, 0, true};
         }
+        level->resize(n);
+        it->resize(n);
+        long long maxFlow = 0;
         
-        return result.str();
+        while (!poller.stopped() && bfs(net, source, sink, *level, *queue, poller)) {
+            std::copy(net.head.begin(), net.head.end() - 1, it->begin());
+            maxFlow += blockingFlow(net, source, sink, *level, *it, *path, poller);
+        }
+        
+        return FlowResult{source, sink, maxFlow, poller.stopped()};
     }
     
     std::string getName() const override {
-        return "Strongly Connected Components";
+        return AlgorithmFactory::info(AlgorithmFactory::AlgorithmType::MAX_FLOW).title;
     }
 };
 
-// Max Flow Algorithm Implementation (Ford-Fulkerson)
-class MaxFlowAlgorithm : public GraphAlgorithm {
+// Max Flow Algorithm Implementation (highest-label push-relabel)
+// Only the first phase runs - it yields a maximum preflow whose sink excess
+// is the max flow value. Gap and periodic global relabeling keep labels exact.
+class MaxFlowPushRelabelAlgorithm final : public GraphAlgorithm {
 private:
-    bool bfs(const std::vector<std::vector<int>>& residual, int source, int sink, 
-             std::vector<int>& parent, int n) {
-        std::vector<bool> visited(n, false);
-        std::queue<int> q;
-        
-        q.push(source);
-        visited[source] = true;
-        parent[source] = -1;
-        
-        while (!q.empty()) {
-            int u = q.front();
-            q.pop();
-            
-            for (int v = 0; v < n; v++) {
-                if (!visited[v] && residual[u][v] > 0) {
-                    q.push(v);
-                    parent[v] = u;
-                    visited[v] = true;
+    struct State {
+        FlowNetwork* net = nullptr;
+        int n = 0;
+        int source = 0;
+        int sink = 0;
+        std::vector<long long> excess;
+        std::vector<int> height;
+        std::vector<int> current;      // Current arc per vertex
+        std::vector<int> activeHead;   // Stack of active vertices per label
+        std::vector<int> activeNext;
+        std::vector<int> bucketHead;   // All labelled vertices per label (doubly linked, for gaps)
+        std::vector<int> bucketNext;
+        std::vector<int> bucketPrev;
+        std::vector<int> queue;        // Global relabel BFS
+        int maxActive = 0;
+        int maxBucket = 0;
+        long long work = 0;
+        
+        // Start a run on network, reusing the arrays of an earlier one
+        void reset(FlowNetwork& network, int s, int t) {
+            net = &network;
+            n = network.n;
+            source = s;
+            sink = t;
+            excess.assign(n, 0);
+            height.assign(n, 0);
+            current.assign(network.head.begin(), network.head.end() - 1);
+            activeHead.assign(n + 1, -1);
+            activeNext.assign(n, -1);
+            bucketHead.assign(n + 1, -1);
+            bucketNext.assign(n, -1);
+            bucketPrev.assign(n, -1);
+            maxActive = 0;
+            maxBucket = 0;
+            work = 0;
+        }
+        
+        void addToBucket(int v) {
+            int h = height[v];
+            bucketPrev[v] = -1;
+            bucketNext[v] = bucketHead[h];
+            if (bucketHead[h] >= 0) bucketPrev[bucketHead[h]] = v;
+            bucketHead[h] = v;
+            maxBucket = std::max(maxBucket, h);
+        }
+        
+        void removeFromBucket(int v) {
+            int h = height[v];
+            if (bucketPrev[v] >= 0) bucketNext[bucketPrev[v]] = bucketNext[v];
+            else bucketHead[h] = bucketNext[v];
+            if (bucketNext[v] >= 0) bucketPrev[bucketNext[v]] = bucketPrev[v];
+        }
+        
+        void activate(int v) {
+            int h = height[v];
+            activeNext[v] = activeHead[h];
+            activeHead[h] = v;
+            maxActive = std::max(maxActive, h);
+        }
+    };
+    
+    // Exact labels = residual BFS distance to the sink; unreachable -> n.
+    // Abandoned half-way when the poller fires, which ends the run.
+    void globalRelabel(State& st, CancellationPoller& poller) {
+        std::fill(st.height.begin(), st.height.end(), st.n);
+        std::fill(st.activeHead.begin(), st.activeHead.end(), -1);
+        std::fill(st.bucketHead.begin(), st.bucketHead.end(), -1);
+        st.maxActive = 0;
+        st.maxBucket = 0;
+        
+        std::vector<int>& queue = st.queue;
+        queue.clear();
+        queue.push_back(st.sink);
+        st.height[st.sink] = 0;
+        for (size_t front = 0; front < queue.size(); front++) {
+            if (poller.poll()) {
+                return;
+            }
+            int v = queue[front];
+            for (int e = st.net->head[v]; e < st.net->head[v + 1]; e++) {
+                int u = st.net->to[e];
+                if (st.height[u] == st.n && u != st.source && st.net->cap[st.net->rev[e]] > 0) {
+                    st.height[u] = st.height[v] + 1;
+                    queue.push_back(u);
                 }
             }
         }
         
-        return visited[sink];
+        for (int v : queue) {
+            if (v == st.sink) continue;
+            st.current[v] = st.net->head[v];
+            st.addToBucket(v);
+            if (st.excess[v] > 0) st.activate(v);
+        }
+        st.work = 0;
+    }
+    
+    // Every vertex labelled above an emptied label can no longer reach the sink
+    void gap(State& st, int emptyLabel) {
+        for (int h = emptyLabel + 1; h <= st.maxBucket; h++) {
+            for (int v = st.bucketHead[h]; v >= 0; v = st.bucketNext[v]) {
+                st.height[v] = st.n;
+            }
+            st.bucketHead[h] = -1;
+            st.activeHead[h] = -1;
+        }
+        st.maxBucket = emptyLabel - 1;
+        st.maxActive = std::min(st.maxActive, emptyLabel - 1);
+    }
+    
+    // Push excess along admissible arcs, relabelling when none is left
+    void discharge(State& st, int u) {
+        FlowNetwork& net = *st.net;
+        while (st.excess[u] > 0) {
+            int end = net.head[u + 1];
+            int& e = st.current[u];
+            for (; e < end; e++) {
+                int v = net.to[e];
+                if (net.cap[e] > 0 && st.height[v] == st.height[u] - 1) {
+                    long long delta = std::min(st.excess[u], net.cap[e]);
+                    if (v != st.sink && st.excess[v] == 0) {
+                        st.activate(v);
+                    }
+                    net.cap[e] -= delta;
+                    net.cap[net.rev[e]] += delta;
+                    st.excess[u] -= delta;
+                    st.excess[v] += delta;
+                    if (st.excess[u] == 0) break;
+                }
+            }
+            if (st.excess[u] == 0) break;
+            
+            // Relabel
+            int oldHeight = st.height[u];
+            int newHeight = st.n;
+            for (int a = net.head[u]; a < end; a++) {
+                if (net.cap[a] > 0) {
+                    newHeight = std::min(newHeight, st.height[net.to[a]] + 1);
+                }
+            }
+            st.work += 12 + (end - net.head[u]);
+            st.removeFromBucket(u);
+            if (st.bucketHead[oldHeight] < 0) {
+                // u was alone on its label: u and everything above are cut off
+                st.height[u] = st.n;
+                gap(st, oldHeight);
+                return;
+            }
+            st.height[u] = newHeight;
+            st.current[u] = net.head[u];
+            if (newHeight >= st.n) return;
+            st.addToBucket(u);
+        }
     }
     
 public:
-    std::string execute(const Graph& graph) override {
+    AlgorithmResult compute(const CSRGraph& graph, Workspace& workspace, const CancellationToken& cancel) override {
         int n = graph.getNumVertices();
-        if (n < 2) return "Graph needs at least 2 vertices for max flow";
+        if (n < 2) return NoticeResult{"Graph needs at least 2 vertices for max flow"};
         
         int source = 0;
         int sink = n - 1;
         
-        // Create adjacency matrix for residual graph
-        std::vector<std::vector<int>> residual(n, std::vector<int>(n, 0));
+        auto network = workspace.borrow<FlowNetwork>();
+        auto state = workspace.borrow<State>();
+        CancellationPoller poller(cancel);
+        FlowNetwork& net = *network;
+        if (!net.build(graph, poller)) {
+            return FlowResult{source, sink, 0, true};
+        }
+        State& st = *state;
+        st.reset(net, source, sink);
+        long long relabelThreshold = 6LL * n + static_cast<long long>(net.to.size()) / 2;
         
-        // Fill residual graph
-        for (int i = 0; i < n; i++) {
-            Neighbor* current = graph.getNeighbors(i);
-            while (current != nullptr) {
-                residual[i][current->dest] = current->weight;
-                current = current->next;
+        // Saturate every arc out of the source
+        for (int e = net.head[source]; e < net.head[source + 1]; e++) {
+            long long delta = net.cap[e];
+            if (delta > 0) {
+                net.cap[e] = 0;
+                net.cap[net.rev[e]] += delta;
+                st.excess[net.to[e]] += delta;
+                st.excess[source] -= delta;
             }
         }
+        // Sink excess of any preflow can be routed as a flow, so a cut-off
+        // run still reports a feasible value
+        globalRelabel(st, poller);
         
-        int maxFlow = 0;
-        std::vector<int> parent(n);
-        
-        // Ford-Fulkerson algorithm
-        while (bfs(residual, source, sink, parent, n)) {
-            int pathFlow = INT_MAX;
-            
-            // Find minimum residual capacity along the path
-            for (int v = sink; v != source; v = parent[v]) {
-                int u = parent[v];
-                pathFlow = std::min(pathFlow, residual[u][v]);
+        while (st.maxActive >= 0 && !poller.poll()) {
+            int h = st.maxActive;
+            int u = st.activeHead[h];
+            if (u < 0) {
+                st.maxActive--;
+                continue;
             }
+            st.activeHead[h] = st.activeNext[u];
+            if (st.height[u] != h || st.excess[u] == 0) continue;
             
-            // Update residual capacities
-            for (int v = sink; v != source; v = parent[v]) {
-                int u = parent[v];
-                residual[u][v] -= pathFlow;
-                residual[v][u] += pathFlow;
+            discharge(st, u);
+            if (st.work > relabelThreshold) {
+                globalRelabel(st, poller);
             }
-            
-            maxFlow += pathFlow;
         }
         
-        return "Max Flow from node 0 to node " + std::to_string(n-1) + ": " + std::to_string(maxFlow);
+        return FlowResult{source, sink, st.excess[sink], poller.stopped()};
     }
     
     std::string getName() const override {
-        return "Max Flow";
+        return AlgorithmFactory::info(AlgorithmFactory::AlgorithmType::MAX_FLOW_PR).title;
     }
 };
 
-// Max Clique Algorithm Implementation (Bron-Kerbosch)
-class MaxCliqueAlgorithm : public GraphAlgorithm {
+// Bit-parallel clique search inside one candidate set (MCQ/MCS style).
+// Candidates are renumbered 0..k-1 so adjacency rows and the per-level
+// candidate sets P are 64-bit word bitsets; P ∩ N(v) is a word-wise AND.
+// Branching follows a greedy colouring of P: a vertex with colour c can
+// extend the current clique by at most c, which prunes most branches.
+// Searches on several threads share the best size found so far through
+// sharedSize, so every thread prunes against the global incumbent.
+// All buffers survive between graphs, so a reused search stops allocating.
+// Once the poller fires the search unwinds, keeping the incumbent it has.
+class BitsetCliqueSearch {
+public:
+    // Start a new search over a graph with n vertices
+    void prepare(int n, std::atomic<size_t>& sharedBest, const CancellationToken& cancel) {
+        // localIndex is all -1 between loads; only new slots need filling
+        if (localIndex.size() < static_cast<size_t>(n)) {
+            localIndex.resize(n, -1);
+        }
+        sharedSize = &sharedBest;
+        poller = CancellationPoller(cancel);
+    }
+    
+    // Whether the time budget cut this search short
+    bool stopped() const {
+        return poller.stopped();
+    }
+    
+    // Build bitset adjacency among candidates; candidate i becomes bit i
+    void load(const CSRGraph& graph, const std::vector<int>& candidates) {
+        k = static_cast<int>(candidates.size());
+        words = (k + 63) / 64;
+        vertices = candidates;
+        for (int i = 0; i < k; i++) {
+            localIndex[vertices[i]] = i;
+        }
+        rows.assign(static_cast<size_t>(k) * words, 0);
+        for (int i = 0; i < k; i++) {
+            for (const auto& edge : graph.neighbors(vertices[i])) {
+                int j = localIndex[edge.dest];
+                if (j >= 0) {
+                    rows[static_cast<size_t>(i) * words + j / 64] |= uint64_t(1) << (j % 64);
+                }
+            }
+        }
+        for (int v : vertices) {
+            localIndex[v] = -1;
+        }
+        byId.resize(k);
+        for (int i = 0; i < k; i++) {
+            byId[i] = i;
+        }
+        std::sort(byId.begin(), byId.end(), [this](int a, int b) {
+            return vertices[a] < vertices[b];
+        });
+        
+        // One level per clique vertex at most, reused across loads
+        if (levels.size() < static_cast<size_t>(k) + 1) {
+            levels.resize(k + 1);
+        }
+    }
+    
+    // Grow best with cliques made of root plus loaded candidates. best is
+    // kept sorted, and equal-size cliques replace it when lexicographically
+    // smaller, so the answer does not depend on the order roots are searched.
+    void improve(int root, std::vector<int>& best) {
+        setAll(levels[0].P);
+        clique.assign(1, root);
+        incumbent = &best;
+        expand(0);
+    }
+    
 private:
-    void bronKerbosch(std::vector<int>& R, std::vector<int>& P, std::vector<int>& X, 
-                      const Graph& graph, std::vector<int>& maxClique, size_t& maxSize) {
-        if (P.empty() && X.empty()) {
-            if (R.size() > maxSize) {
-                maxSize = R.size();
-                maxClique = R;
+    struct Level {
+        std::vector<uint64_t> P;
+        std::vector<uint64_t> uncolored;
+        std::vector<uint64_t> colorClass;
+        std::vector<uint64_t> lowClasses;  // Classes 1..kmin-1, kept for re-numbering
+        std::vector<int> order;   // Branching vertices in colour order
+        std::vector<int> colors;  // Non-decreasing colour of order[i]
+    };
+    
+    const uint64_t* row(int v) const {
+        return rows.data() + static_cast<size_t>(v) * words;
+    }
+    
+    void setAll(std::vector<uint64_t>& set) const {
+        set.assign(words, ~uint64_t(0));
+        if (k % 64 != 0) {
+            set[words - 1] = (uint64_t(1) << (k % 64)) - 1;
+        }
+    }
+    
+    bool empty(const std::vector<uint64_t>& set) const {
+        for (int w = 0; w < words; w++) {
+            if (set[w] != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Size a clique must reach to matter: the larger of this search's
+    // incumbent and the best any thread has published
+    size_t targetSize() const {
+        return std::max(incumbent->size(), sharedSize->load(std::memory_order_relaxed));
+    }
+    
+    // Whether some clique of the target size made of the current clique
+    // plus vertices of P could be lexicographically smaller than ours. The
+    // smallest such candidate takes the lowest ids of P, and every real
+    // clique is element-wise no smaller, so it is enough to test that one.
+    // Another thread's clique is not visible here, so ties against it stay open.
+    bool canBeatOnTie(const std::vector<uint64_t>& P, size_t target) {
+        const std::vector<int>& best = *incumbent;
+        if (best.size() != target) {
+            return true;
+        }
+        sortedClique = clique;
+        std::sort(sortedClique.begin(), sortedClique.end());
+        size_t fromClique = 0;
+        int fromP = 0;
+        for (size_t i = 0; i < best.size(); i++) {
+            while (fromP < k && (P[byId[fromP] / 64] >> (byId[fromP] % 64) & 1) == 0) {
+                fromP++;
+            }
+            int next;
+            if (fromClique < sortedClique.size() && (fromP == k || sortedClique[fromClique] < vertices[byId[fromP]])) {
+                next = sortedClique[fromClique++];
+            } else if (fromP < k) {
+                next = vertices[byId[fromP++]];
+            } else {
+                return false;
+            }
+            if (next != best[i]) {
+                return next < best[i];
+            }
+        }
+        return false;
+    }
+    
+    // MCS re-numbering: move v into a low class k1 where it has a single
+    // neighbour u, if u can in turn move to a later low class k2
+    bool renumber(Level& level, int v, int lowCount) {
+        const uint64_t* adj = row(v);
+        for (int k1 = 0; k1 < lowCount; k1++) {
+            uint64_t* c1 = level.lowClasses.data() + static_cast<size_t>(k1) * words;
+            int u = -1;
+            int count = 0;
+            for (int w = 0; w < words && count < 2; w++) {
+                uint64_t common = adj[w] & c1[w];
+                if (common != 0) {
+                    count += __builtin_popcountll(common);
+                    u = w * 64 + __builtin_ctzll(common);
+                }
             }
+            if (count == 0) {
+                c1[v / 64] |= uint64_t(1) << (v % 64);
+                return true;
+            }
+            if (count > 1) {
+                continue;
+            }
+            const uint64_t* adjU = row(u);
+            for (int k2 = k1 + 1; k2 < lowCount; k2++) {
+                uint64_t* c2 = level.lowClasses.data() + static_cast<size_t>(k2) * words;
+                bool free = true;
+                for (int w = 0; w < words && free; w++) {
+                    free = (adjU[w] & c2[w]) == 0;
+                }
+                if (free) {
+                    c1[u / 64] &= ~(uint64_t(1) << (u % 64));
+                    c2[u / 64] |= uint64_t(1) << (u % 64);
+                    c1[v / 64] |= uint64_t(1) << (v % 64);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    
+    // Greedy sequential colouring of P, one colour class at a time. Vertices
+    // coloured below kmin cannot beat the incumbent and are never branched
+    // on, so only colours >= kmin go into the branching order.
+    void colorSort(Level& level, int kmin) {
+        int lowCount = std::max(kmin - 1, 0);
+        level.uncolored = level.P;
+        level.colorClass.resize(words);
+        level.lowClasses.assign(static_cast<size_t>(lowCount) * words, 0);
+        level.order.clear();
+        level.colors.clear();
+        int color = 0;
+        while (!empty(level.uncolored)) {
+            color++;
+            level.colorClass = level.uncolored;
+            for (int w = 0; w < words; w++) {
+                while (level.colorClass[w] != 0) {
+                    int bit = __builtin_ctzll(level.colorClass[w]);
+                    int v = w * 64 + bit;
+                    level.colorClass[w] &= ~(uint64_t(1) << bit);
+                    level.uncolored[w] &= ~(uint64_t(1) << bit);
+                    if (color < kmin) {
+                        level.lowClasses[static_cast<size_t>(color - 1) * words + w] |= uint64_t(1) << bit;
+                    } else if (renumber(level, v, lowCount)) {
+                        continue;
+                    } else {
+                        level.order.push_back(v);
+                        level.colors.push_back(color);
+                    }
+                    // Later members of this class must be non-adjacent to v
+                    const uint64_t* adj = row(v);
+                    for (int x = w; x < words; x++) {
+                        level.colorClass[x] &= ~adj[x];
+                    }
+                }
+            }
+        }
+    }
+    
+    // Keep a clique that reaches the target, preferring the
+    // lexicographically smaller one on ties, and publish its size
+    void record() {
+        std::vector<int>& best = *incumbent;
+        if (clique.size() < targetSize() || clique.size() < best.size()) {
+            return;
+        }
+        sortedClique = clique;
+        std::sort(sortedClique.begin(), sortedClique.end());
+        if (sortedClique.size() == best.size() && !(sortedClique < best)) {
+            return;
+        }
+        best = sortedClique;
+        size_t published = sharedSize->load(std::memory_order_relaxed);
+        while (published < best.size() && !sharedSize->compare_exchange_weak(published, best.size(), std::memory_order_relaxed)) {
+        }
+    }
+    
+    void expand(int depth) {
+        if (poller.poll()) {
             return;
         }
+        Level& level = levels[depth];
+        if (empty(level.P)) {
+            record();
+            return;
+        }
+        // Equal-size cliques can still win the tie, so only strictly worse
+        // colours are pruned
+        colorSort(level, static_cast<int>(targetSize()) - static_cast<int>(clique.size()));
         
-        std::vector<int> P_copy = P;
-        for (int v : P_copy) {
-            std::vector<int> R_new = R;
-            R_new.push_back(v);
-            
-            std::vector<int> P_new, X_new;
-            
-            // P ∩ N(v)
-            for (int u : P) {
-                if (graph.hasEdge(v, u)) {
-                    P_new.push_back(u);
-                }
+        bool tieChecked = false;
+        for (int i = static_cast<int>(level.order.size()) - 1; i >= 0; i--) {
+            size_t bound = clique.size() + level.colors[i];
+            size_t target = targetSize();
+            if (bound < target) {
+                return;
             }
-            
-            // X ∩ N(v)
-            for (int u : X) {
-                if (graph.hasEdge(v, u)) {
-                    X_new.push_back(u);
+            if (bound == target && !tieChecked) {
+                if (!canBeatOnTie(level.P, target)) {
+                    return;
                 }
+                tieChecked = true;
             }
-            
-            bronKerbosch(R_new, P_new, X_new, graph, maxClique, maxSize);
-            
-            // Move v from P to X
-            P.erase(std::remove(P.begin(), P.end(), v), P.end());
-            X.push_back(v);
+            int v = level.order[i];
+            Level& next = levels[depth + 1];
+            next.P.resize(words);
+            const uint64_t* adj = row(v);
+            for (int w = 0; w < words; w++) {
+                next.P[w] = level.P[w] & adj[w];
+            }
+            clique.push_back(vertices[v]);
+            expand(depth + 1);
+            clique.pop_back();
+            if (poller.stopped()) {
+                return;
+            }
+            level.P[v / 64] &= ~(uint64_t(1) << (v % 64));
         }
     }
     
-public:
-    std::string execute(const Graph& graph) override {
+    int k = 0;
+    int words = 0;
+    std::vector<int> localIndex;   // Global vertex -> candidate index, -1 outside
+    std::vector<int> vertices;     // Candidate index -> global vertex
+    std::vector<uint64_t> rows;
+    std::vector<Level> levels;
+    std::vector<int> byId;         // Candidate indices in ascending vertex order
+    std::vector<int> clique;
+    std::vector<int> sortedClique;
+    std::vector<int>* incumbent = nullptr;
+    std::atomic<size_t>* sharedSize = nullptr;
+    CancellationPoller poller;
+};
+
+// Max Clique Algorithm Implementation (bitset Bron-Kerbosch with colouring bounds)
+class MaxCliqueAlgorithm final : public GraphAlgorithm {
+private:
+    // Smaller graphs are searched on the calling thread
+    static constexpr int PARALLEL_MIN_VERTICES = 64;
+    
+    unsigned int threads;
+    
+    // Per-worker search state and incumbent; only the best size is shared
+    struct Worker {
+        BitsetCliqueSearch search;
+        std::vector<int> candidates;
+        std::vector<int> best;
+    };
+    
+    // Degeneracy (smallest-last) order: position[v] is v's index in the order
+    // and core[v] its core number. Every vertex has at most degeneracy
+    // neighbours later in the order.
+    void degeneracyOrder(const CSRGraph& graph, Workspace& workspace, std::vector<int>& order,
+                         std::vector<int>& position, std::vector<int>& core) {
         int n = graph.getNumVertices();
-        if (n == 0) return "Graph is empty";
+        core.resize(n);
+        int maxDegree = 0;
+        for (int v = 0; v < n; v++) {
+            core[v] = graph.getDegree(v);
+            maxDegree = std::max(maxDegree, core[v]);
+        }
+        
+        // Bucket sort vertices by degree, then peel minimum-degree vertices
+        auto bucketLease = workspace.borrow<std::vector<int>>();
+        std::vector<int>& bucketStart = *bucketLease;
+        bucketStart.assign(maxDegree + 2, 0);
+        for (int v = 0; v < n; v++) {
+            bucketStart[core[v] + 1]++;
+        }
+        for (int d = 0; d <= maxDegree; d++) {
+            bucketStart[d + 1] += bucketStart[d];
+        }
+        order.resize(n);
+        position.resize(n);
+        {
+            auto fill = workspace.borrow<std::vector<int>>();
+            fill->assign(bucketStart.begin(), bucketStart.end() - 1);
+            for (int v = 0; v < n; v++) {
+                position[v] = (*fill)[core[v]]++;
+                order[position[v]] = v;
+            }
+        }
         
-        std::vector<int> R, P, X;
         for (int i = 0; i < n; i++) {
-            P.push_back(i);
+            int v = order[i];
+            for (const auto& edge : graph.neighbors(v)) {
+                int u = edge.dest;
+                if (core[u] > core[v]) {
+                    // Swap u to the front of its bucket, then shrink the bucket
+                    int du = core[u];
+                    int front = bucketStart[du];
+                    int w = order[front];
+                    if (w != u) {
+                        std::swap(order[front], order[position[u]]);
+                        position[w] = position[u];
+                        position[u] = front;
+                    }
+                    bucketStart[du]++;
+                    core[u]--;
+                }
+            }
         }
+    }
+    
+public:
+    explicit MaxCliqueAlgorithm(unsigned int threads) : threads(threads) {}
+    
+    AlgorithmResult compute(const CSRGraph& graph, Workspace& workspace, const CancellationToken& cancel) override {
+        // Cliques of a directed graph are those of its underlying undirected graph
+        if (graph.isDirected()) return compute(graph.symmetrized(), workspace, cancel);
         
-        std::vector<int> maxClique;
-        size_t maxSize = 0;
+        int n = graph.getNumVertices();
+        if (n == 0) return NoticeResult{"Graph is empty"};
         
-        bronKerbosch(R, P, X, graph, maxClique, maxSize);
+        auto orderLease = workspace.borrow<std::vector<int>>();
+        auto positionLease = workspace.borrow<std::vector<int>>();
+        auto coreLease = workspace.borrow<std::vector<int>>();
+        std::vector<int>& order = *orderLease;
+        std::vector<int>& position = *positionLease;
+        std::vector<int>& core = *coreLease;
+        degeneracyOrder(graph, workspace, order, position, core);
         
-        std::stringstream result;
-        result << "Max Clique Size: " << maxSize << "\n";
-        result << "Max Clique Vertices: {";
-        for (size_t i = 0; i < maxClique.size(); i++) {
-            if (i > 0) result << ", ";
-            result << maxClique[i];
+        WorkStealingPool pool(n < PARALLEL_MIN_VERTICES ? 1 : threads);
+        std::atomic<size_t> bestSize(0);
+        auto workerLease = workspace.borrow<std::vector<Worker>>();
+        std::vector<Worker>& workers = *workerLease;
+        if (workers.size() < pool.size()) {
+            workers.resize(pool.size());
         }
-        result << "}";
+        for (unsigned int i = 0; i < pool.size(); i++) {
+            workers[i].search.prepare(n, bestSize, cancel);
+            workers[i].best.clear();
+        }
+        
+        // Each clique is searched once, from its earliest vertex in
+        // degeneracy order. Dense cores come last, so their roots are handed
+        // out first to raise the bound early.
+        pool.run(n, [&](size_t task, unsigned int id) {
+            Worker& worker = workers[id];
+            if (worker.search.stopped()) {
+                return;
+            }
+            int i = n - 1 - static_cast<int>(task);
+            int v = order[i];
+            size_t target = std::max(worker.best.size(), bestSize.load(std::memory_order_relaxed));
+            if (static_cast<size_t>(core[v]) + 1 < target) {
+                return;
+            }
+            worker.candidates.clear();
+            for (const auto& edge : graph.neighbors(v)) {
+                if (position[edge.dest] > i) {
+                    worker.candidates.push_back(edge.dest);
+                }
+            }
+            if (worker.candidates.size() + 1 < target) {
+                return;
+            }
+            // Higher-core vertices first helps the colouring
+            std::sort(worker.candidates.begin(), worker.candidates.end(), [&position](int a, int b) {
+                return position[a] > position[b];
+            });
+            worker.search.load(graph, worker.candidates);
+            worker.search.improve(v, worker.best);
+        });
         
-        return result.str();
+        // Unless the budget ran out, every maximum clique is either some
+        // worker's incumbent or loses the tie to it, so the smallest of the
+        // largest is the same for any number of threads
+        std::vector<int> maxClique;
+        bool partial = false;
+        for (unsigned int i = 0; i < pool.size(); i++) {
+            const Worker& worker = workers[i];
+            partial = partial || worker.search.stopped();
+            if (worker.best.size() > maxClique.size() || (worker.best.size() == maxClique.size() && worker.best < maxClique)) {
+                maxClique = worker.best;
+            }
+        }
+        
+        return CliqueResult{std::move(maxClique), partial};
     }
     
     std::string getName() const override {
-        return "Max Clique";
+        return AlgorithmFactory::info(AlgorithmFactory::AlgorithmType::MAX_CLIQUE).title;
     }
 };
 
-// Factory implementation
-std::unique_ptr<GraphAlgorithm> AlgorithmFactory::createAlgorithm(AlgorithmType type) {
-    switch (type) {
-        case AlgorithmType::MST_WEIGHT:
-            return std::make_unique<MSTWeightAlgorithm>();
-        case AlgorithmType::SCC:
-            return std::make_unique<SCCAlgorithm>();
-        case AlgorithmType::MAX_FLOW:
-            return std::make_unique<MaxFlowAlgorithm>();
-        case AlgorithmType::MAX_CLIQUE:
-            return std::make_unique<MaxCliqueAlgorithm>();
-        default:
-            return nullptr;
+// Registry of every engine; the order must match AlgorithmType
+const std::vector<AlgorithmFactory::AlgorithmInfo>& AlgorithmFactory::registry() {
+    static const std::vector<AlgorithmInfo> entries = {
+        {AlgorithmType::MST_WEIGHT, "MST_WEIGHT", "MST Weight", Problem::SPANNING_TREE, true},
+        {AlgorithmType::MST_KRUSKAL, "MST_KRUSKAL", "MST Weight (Kruskal)", Problem::SPANNING_TREE, false},
+        {AlgorithmType::MST_BORUVKA, "MST_BORUVKA", "MST Weight (Boruvka)", Problem::SPANNING_TREE, false},
+        {AlgorithmType::SCC, "SCC", "Strongly Connected Components", Problem::SCC, true},
+        {AlgorithmType::MAX_FLOW, "MAX_FLOW", "Max Flow", Problem::MAX_FLOW, true},
+        {AlgorithmType::MAX_FLOW_PR, "MAX_FLOW_PR", "Max Flow (Push-Relabel)", Problem::MAX_FLOW, false},
+        {AlgorithmType::MAX_CLIQUE, "MAX_CLIQUE", "Max Clique", Problem::MAX_CLIQUE, true}
+    };
+    return entries;
+}
+
+static bool isRegistered(AlgorithmFactory::AlgorithmType type) {
+    return static_cast<size_t>(type) < AlgorithmFactory::registry().size();
+}
+
+const AlgorithmFactory::AlgorithmInfo& AlgorithmFactory::info(AlgorithmType type) {
+    if (!isRegistered(type)) {
+        throw std::invalid_argument("Unknown algorithm type");
     }
+    return registry()[static_cast<size_t>(type)];
 }
 
-std::string AlgorithmFactory::getAlgorithmName(AlgorithmType type) {
+const AlgorithmFactory::AlgorithmInfo* AlgorithmFactory::find(const std::string& key) {
+    for (const AlgorithmInfo& entry : registry()) {
+        if (key == entry.key) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+AlgorithmFactory::AlgorithmType AlgorithmFactory::select(Problem problem, const std::string& requested) {
+    const AlgorithmInfo* entry = find(requested);
+    if (entry != nullptr && entry->problem == problem) {
+        return entry->type;
+    }
+    for (const AlgorithmInfo& candidate : registry()) {
+        if (candidate.problem == problem && candidate.preferred) {
+            return candidate.type;
+        }
+    }
+    throw std::invalid_argument("No engine registered for problem");
+}
+
+std::string AlgorithmFactory::availableNames() {
+    std::string names;
+    for (const AlgorithmInfo& entry : registry()) {
+        if (!names.empty()) names += ", ";
+        names += entry.key;
+    }
+    return names;
+}
+
+// Call f with the concrete engine for `type`. The engines are final, so
+// calls through the reference bind statically and can be inlined.
+template<typename F>
+static decltype(auto) withAlgorithm(AlgorithmFactory::AlgorithmType type, unsigned int threads, F&& f) {
     switch (type) {
-        case AlgorithmType::MST_WEIGHT:
-            return "MST_WEIGHT";
-        case AlgorithmType::SCC:
-            return "SCC";
-        case AlgorithmType::MAX_FLOW:
-            return "MAX_FLOW";
-        case AlgorithmType::MAX_CLIQUE:
-            return "MAX_CLIQUE";
-        default:
-            return "UNKNOWN";
+        case AlgorithmFactory::AlgorithmType::MST_WEIGHT: {
+            MSTWeightAlgorithm algorithm;
+            return f(algorithm);
+        }
+        case AlgorithmFactory::AlgorithmType::MST_KRUSKAL: {
+            KruskalMSTAlgorithm algorithm;
+            return f(algorithm);
+        }
+        case AlgorithmFactory::AlgorithmType::MST_BORUVKA: {
+            BoruvkaMSTAlgorithm algorithm(threads);
+            return f(algorithm);
+        }
+        case AlgorithmFactory::AlgorithmType::SCC: {
+            SCCAlgorithm algorithm;
+            return f(algorithm);
+        }
+        case AlgorithmFactory::AlgorithmType::MAX_FLOW: {
+            MaxFlowAlgorithm algorithm;
+            return f(algorithm);
+        }
+        case AlgorithmFactory::AlgorithmType::MAX_FLOW_PR: {
+            MaxFlowPushRelabelAlgorithm algorithm;
+            return f(algorithm);
+        }
+        case AlgorithmFactory::AlgorithmType::MAX_CLIQUE: {
+            MaxCliqueAlgorithm algorithm(threads);
+            return f(algorithm);
+        }
+    }
+    throw std::invalid_argument("Unknown algorithm type");
+}
+
+AlgorithmResult AlgorithmFactory::run(AlgorithmType type, const CSRGraph& graph, Workspace& workspace,
+                                      const CancellationToken& cancel, unsigned int threads) {
+    return withAlgorithm(type, threads, [&](auto& algorithm) { return algorithm.compute(graph, workspace, cancel); });
+}
+
+AlgorithmResult AlgorithmFactory::run(AlgorithmType type, const CSRGraph& graph, Workspace& workspace, unsigned int threads) {
+    CancellationToken never;
+    return run(type, graph, workspace, never, threads);
+}
+
+AlgorithmResult AlgorithmFactory::run(AlgorithmType type, const CSRGraph& graph, unsigned int threads) {
+    Workspace workspace;
+    return run(type, graph, workspace, threads);
+}
+
+// Factory implementation
+std::unique_ptr<GraphAlgorithm> AlgorithmFactory::createAlgorithm(AlgorithmType type, unsigned int threads) {
+    if (!isRegistered(type)) {
+        return nullptr;
     }
+    return withAlgorithm(type, threads, [](auto& algorithm) -> std::unique_ptr<GraphAlgorithm> {
+        return std::make_unique<std::decay_t<decltype(algorithm)>>(algorithm);
+    });
+}
+
+std::string AlgorithmFactory::getAlgorithmName(AlgorithmType type) {
+    return isRegistered(type) ? info(type).key : "UNKNOWN";
 }
 
 } // namespace graph
@@ -13,6 +13,7 @@
 #include <thread>
 #include <mutex>
 #include <chrono>
+#include <sstream>
 #include "graph.hpp"
 #include "graph_algorithm.hpp"
 
@@ -82,7 +83,7 @@ void analyzeGraph(const graph::Graph& g) {
     std::cout << std::string(50, '=') << "\n";
 }
 
-std::string processGraphRequest(const std::string &request)
+std::string processGraphRequest(const std::string &request, graph::Workspace &workspace)
 {
     // Parse request like "-e 5 -v 4 -s 43 -a MST_WEIGHT"
     int edges = -1, vertices = -1, seed = -1;
@@ -110,13 +111,13 @@ std::string processGraphRequest(const std::string &request)
     pos = request.find("-a ");
     if (pos != std::string::npos)
     {
-        algorithm = request.substr(pos + 3);
+        std::istringstream(request.substr(pos + 3)) >> algorithm;
     }
 
     if (edges < 0 || vertices <= 0)
     {
         return "ERROR: Invalid parameters. Use format: -e <edges> -v <vertices> -s <seed> [-a <algorithm>]\n"
-               "Available algorithms: EULER, MST_WEIGHT, SCC, MAX_FLOW, MAX_CLIQUE";
+               "Available algorithms: EULER, " + graph::AlgorithmFactory::availableNames();
     }
 
     try
@@ -152,31 +153,17 @@ std::string processGraphRequest(const std::string &request)
                 analyzeGraph(graph);
             }
         } else {
-            graph::AlgorithmFactory::AlgorithmType algoType;
-            
-            if (algorithm == "MST_WEIGHT") {
-                algoType = graph::AlgorithmFactory::AlgorithmType::MST_WEIGHT;
-            } else if (algorithm == "SCC") {
-                algoType = graph::AlgorithmFactory::AlgorithmType::SCC;
-            } else if (algorithm == "MAX_FLOW") {
-                algoType = graph::AlgorithmFactory::AlgorithmType::MAX_FLOW;
-            } else if (algorithm == "MAX_CLIQUE") {
-                algoType = graph::AlgorithmFactory::AlgorithmType::MAX_CLIQUE;
-            } else {
-                return "ERROR: Unknown algorithm '" + algorithm + "'. Available: EULER, MST_WEIGHT, SCC, MAX_FLOW, MAX_CLIQUE";
-            }
-            
-            auto algo = graph::AlgorithmFactory::createAlgorithm(algoType);
-            if (!algo) {
-                return "ERROR: Failed to create algorithm instance";
+            const graph::AlgorithmFactory::AlgorithmInfo* info = graph::AlgorithmFactory::find(algorithm);
+            if (info == nullptr) {
+                return "ERROR: Unknown algorithm '" + algorithm + "'. Available: EULER, " + graph::AlgorithmFactory::availableNames();
             }
             
-            result = "ALGORITHM: " + algo->getName() + "\n";
+            result = "ALGORITHM: " + std::string(info->title) + "\n";
             result += "Vertices: " + std::to_string(vertices) + "\n";
             result += "Edges: " + std::to_string(edges) + "\n";
             result += "Seed: " + std::to_string(seed) + "\n";
             result += "Result:\n";
-            result += algo->execute(graph);
+            graph::appendText(result, graph::AlgorithmFactory::run(info->type, graph::CSRGraph(graph), workspace));
 
             
             // Display graph info
@@ -194,6 +181,7 @@ std::string processGraphRequest(const std::string &request)
 void handleClient(int client_fd, const std::string &client_ip)
 {
     std::cout << "Starting client handler for " << client_ip << std::endl;
+    graph::Workspace workspace; // Scratch arrays reused across this client's requests
 
     while (running)
     {
@@ -207,7 +195,7 @@ void handleClient(int client_fd, const std::string &client_ip)
             std::cout << "Received from " << client_ip << ": " << request << std::endl;
 
             // proccess request
-            std::string response = processGraphRequest(request);
+            std::string response = processGraphRequest(request, workspace);
 
              if (send(client_fd, response.c_str(), response.length(), 0) < 0)
             {
@@ -0,0 +1,199 @@
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace graph {
+
+    // One run(): the dealt tasks and the workers taking part in it
+    struct WorkStealingPool::Job {
+        struct TaskQueue {
+            std::mutex mutex;
+            std::deque<size_t> tasks;
+        };
+
+        Job(const std::function<void(size_t, unsigned int)>& body, unsigned int workers)
+            : body(body), workers(workers), queues(new TaskQueue[workers]) {}
+
+        const std::function<void(size_t, unsigned int)>& body;
+        unsigned int workers;
+        std::unique_ptr<TaskQueue[]> queues;
+        unsigned int claimed = 1;      // Worker ids handed out; the caller is 0
+        unsigned int finished = 0;     // Helpers done with this job
+        std::mutex doneMutex;
+        std::condition_variable done;
+        std::exception_ptr failure;
+        std::mutex failureMutex;
+
+        // Take the next task of this worker's own deque
+        bool pop(unsigned int worker, size_t& task) {
+            std::lock_guard<std::mutex> lock(queues[worker].mutex);
+            if (queues[worker].tasks.empty()) {
+                return false;
+            }
+            task = queues[worker].tasks.front();
+            queues[worker].tasks.pop_front();
+            return true;
+        }
+
+        // Take the last task of some other worker, starting with the next one
+        bool steal(unsigned int thief, size_t& task) {
+            for (unsigned int i = 1; i < workers; i++) {
+                TaskQueue& victim = queues[(thief + i) % workers];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task = victim.tasks.back();
+                    victim.tasks.pop_back();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Nothing is ever pushed while running, so once both the own deque
+        // and every victim are empty the worker is done. The first exception
+        // wins; the remaining tasks are dropped unrun.
+        void work(unsigned int worker) {
+            try {
+                size_t task;
+                while (pop(worker, task) || steal(worker, task)) {
+                    body(task, worker);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                for (unsigned int i = 0; i < workers; i++) {
+                    std::lock_guard<std::mutex> queueLock(queues[i].mutex);
+                    queues[i].tasks.clear();
+                }
+            }
+        }
+    };
+
+    // Process-wide helper threads, started on demand until there are enough
+    // for the widest job seen and kept for the rest of the process. An idle
+    // helper joins the oldest job that still has a free worker id; the
+    // thread that called run() always works on its own job, so a job
+    // finishes even when every helper is busy.
+    class WorkStealingPool::Helpers {
+    public:
+        static Helpers& instance() {
+            static Helpers helpers;
+            return helpers;
+        }
+
+        void offer(Job* job) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                open.push_back(job);
+                while (threads.size() + 1 < job->workers) {
+                    threads.emplace_back(&Helpers::loop, this);
+                }
+            }
+            for (unsigned int i = 1; i < job->workers; i++) {
+                wake.notify_one();
+            }
+        }
+
+        // Close job to further helpers; returns how many joined it
+        unsigned int withdraw(Job* job) {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = std::find(open.begin(), open.end(), job);
+            if (it != open.end()) {
+                open.erase(it);
+            }
+            return job->claimed - 1;
+        }
+
+    private:
+        Helpers() = default;
+
+        ~Helpers() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        void loop() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                wake.wait(lock, [this] { return stopping || !open.empty(); });
+                if (stopping) {
+                    return;
+                }
+                Job* job = open.front();
+                unsigned int worker = job->claimed++;
+                if (job->claimed == job->workers) {
+                    open.pop_front();
+                }
+                lock.unlock();
+                job->work(worker);
+                {
+                    // Notify under the lock: the job lives on the caller's
+                    // stack and is gone as soon as the caller sees the count
+                    std::lock_guard<std::mutex> doneLock(job->doneMutex);
+                    job->finished++;
+                    job->done.notify_one();
+                }
+                lock.lock();
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<Job*> open;      // Jobs with worker ids left to hand out
+        std::vector<std::thread> threads;
+        bool stopping = false;
+    };
+
+    WorkStealingPool::WorkStealingPool(unsigned int threads) : workers(threads) {
+        if (workers == 0) {
+            workers = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    // Get number of workers
+    unsigned int WorkStealingPool::size() const {
+        return workers;
+    }
+
+    // Deal tasks out and run them; the caller acts as worker 0
+    void WorkStealingPool::run(size_t count, const std::function<void(size_t, unsigned int)>& body) {
+        unsigned int active = static_cast<unsigned int>(std::min<size_t>(workers, count));
+        if (active <= 1) {
+            for (size_t task = 0; task < count; task++) {
+                body(task, 0);
+            }
+            return;
+        }
+
+        Job job(body, active);
+        for (size_t task = 0; task < count; task++) {
+            job.queues[task % active].tasks.push_back(task);
+        }
+        Helpers& helpers = Helpers::instance();
+        helpers.offer(&job);
+        job.work(0);
+        unsigned int joined = helpers.withdraw(&job);
+        {
+            std::unique_lock<std::mutex> lock(job.doneMutex);
+            job.done.wait(lock, [&] { return job.finished == joined; });
+        }
+        if (job.failure) {
+            std::rethrow_exception(job.failure);
+        }
+    }
+
+} // namespace graph
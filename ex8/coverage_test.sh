@@ -22,13 +22,16 @@ CXXFLAGS="-std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage" make clean
 # Compile individual object files with coverage
 echo "Compiling source files with coverage..."
 g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c graph.cpp -o graph.o
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c csr_graph.cpp -o csr_graph.o
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c work_stealing_pool.cpp -o work_stealing_pool.o
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c algorithm_result.cpp -o algorithm_result.o
 g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c point.cpp -o point.o
 g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c graph_algorithms.cpp -o graph_algorithms.o
 g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c test_algorithms.cpp -o test_algorithms.o
 
 # Link with coverage library
 echo "Linking test executable with coverage..."
-g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage graph.o point.o graph_algorithms.o test_algorithms.o -o test_algorithms
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage graph.o csr_graph.o work_stealing_pool.o algorithm_result.o point.o graph_algorithms.o test_algorithms.o -o test_algorithms -pthread
 
 if [ $? -ne 0 ]; then
     echo "ERROR: Build failed!"
@@ -50,7 +53,7 @@ echo "Generating coverage reports for YOUR source files only..."
 echo "========================================"
 
 # Only process YOUR source files, not external libraries
-YOUR_SOURCE_FILES=("graph.cpp" "point.cpp" "graph_algorithms.cpp")
+YOUR_SOURCE_FILES=("graph.cpp" "csr_graph.cpp" "work_stealing_pool.cpp" "algorithm_result.cpp" "point.cpp" "graph_algorithms.cpp")
 
 for src_file in "${YOUR_SOURCE_FILES[@]}"; do
     if [ -f "$src_file" ]; then
@@ -114,6 +117,9 @@ echo "  - Lines starting with numbers show execution count"
 echo
 echo "Coverage summary:"
 echo "  - graph.cpp.gcov - Graph implementation coverage"
+echo "  - csr_graph.cpp.gcov - CSR graph coverage"
+echo "  - work_stealing_pool.cpp.gcov - Work-stealing pool coverage"
+echo "  - algorithm_result.cpp.gcov - Result serializer coverage"
 echo "  - point.cpp.gcov - Point class coverage"
 echo "  - graph_algorithms.cpp.gcov - Algorithm implementations coverage"
 echo
@@ -0,0 +1,185 @@
+#include "csr_graph.hpp"
+#include "connected_components.hpp"
+#include <stdexcept>
+
+namespace graph {
+
+    // Empty CSR with n vertices and offsets ready to be filled
+    CSRGraph::CSRGraph(int n, bool directed) : numVertices(n), directed(directed), offsets(n + 1, 0) {
+        if (n <= 0) {
+            throw std::invalid_argument("Number of vertices must be positive");
+        }
+    }
+
+    // Snapshot an existing linked-list graph
+    CSRGraph::CSRGraph(const Graph& graph) : CSRGraph(graph.getNumVertices(), graph.isDirected()) {
+        for (int i = 0; i < numVertices; i++) {
+            offsets[i + 1] = offsets[i] + graph.getDegree(i);
+        }
+
+        dests.resize(offsets[numVertices]);
+        weights.resize(offsets[numVertices]);
+        for (int i = 0; i < numVertices; i++) {
+            int pos = offsets[i];
+            for (Neighbor* current = graph.getNeighbors(i); current != nullptr; current = current->next) {
+                dests[pos] = current->dest;
+                weights[pos] = current->weight;
+                pos++;
+            }
+        }
+    }
+
+    // Build from distinct edges. Graph::addEdge prepends, so each vertex
+    // lists its neighbors in reverse insertion order - replay that here.
+    CSRGraph CSRGraph::fromEdges(int vertices, const std::vector<std::pair<int, int>>& edges, int weight,
+                                 bool directed) {
+        CSRGraph csr(vertices, directed);
+        for (const auto& edge : edges) {
+            if (edge.first < 0 || edge.first >= vertices || edge.second < 0 || edge.second >= vertices) {
+                throw std::out_of_range("Vertex index out of range");
+            }
+            if (edge.first == edge.second) {
+                throw std::invalid_argument("Self loops are not allowed");
+            }
+            csr.offsets[edge.first + 1]++;
+            if (!directed) {
+                csr.offsets[edge.second + 1]++;
+            }
+        }
+        for (int i = 0; i < vertices; i++) {
+            csr.offsets[i + 1] += csr.offsets[i];
+        }
+
+        csr.dests.resize(csr.offsets[vertices]);
+        csr.weights.assign(csr.offsets[vertices], weight);
+        std::vector<int> pos(csr.offsets.begin(), csr.offsets.end() - 1);
+        for (auto it = edges.rbegin(); it != edges.rend(); ++it) {
+            csr.dests[pos[it->first]++] = it->second;
+            if (!directed) {
+                csr.dests[pos[it->second]++] = it->first;
+            }
+        }
+        return csr;
+    }
+
+    // Generate random graph straight into CSR form
+    CSRGraph CSRGraph::generateRandomGraph(int vertices, int edges, unsigned int seed, unsigned int threads,
+                                           bool directed) {
+        return fromEdges(vertices, Graph::generateRandomEdges(vertices, edges, seed, threads, directed), 1, directed);
+    }
+
+    // Get number of vertices
+    int CSRGraph::getNumVertices() const {
+        return numVertices;
+    }
+
+    // Get number of edges
+    int CSRGraph::getNumEdges() const {
+        return directed ? offsets[numVertices] : offsets[numVertices] / 2;
+    }
+
+    // Get degree
+    int CSRGraph::getDegree(int vertex) const {
+        if (vertex < 0 || vertex >= numVertices) {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        return offsets[vertex + 1] - offsets[vertex];
+    }
+
+    // Get neighbors as a contiguous range
+    CSRGraph::NeighborRange CSRGraph::neighbors(int vertex) const {
+        if (vertex < 0 || vertex >= numVertices) {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        int begin = offsets[vertex];
+        return NeighborRange(dests.data() + begin, weights.data() + begin, offsets[vertex + 1] - begin);
+    }
+
+    // Check if edge exists
+    bool CSRGraph::hasEdge(int src, int dest) const {
+        if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        for (int i = offsets[src]; i < offsets[src + 1]; i++) {
+            if (dests[i] == dest) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Get edge weight
+    int CSRGraph::getEdgeWeight(int src, int dest) const {
+        if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        for (int i = offsets[src]; i < offsets[src + 1]; i++) {
+            if (dests[i] == dest) {
+                return weights[i];
+            }
+        }
+        throw std::runtime_error("Edge not found");
+    }
+
+    // Reverse every half-edge (u -> v becomes v -> u)
+    CSRGraph CSRGraph::transposed() const {
+        CSRGraph result(numVertices, directed);
+        for (int dest : dests) {
+            result.offsets[dest + 1]++;
+        }
+        for (int i = 0; i < numVertices; i++) {
+            result.offsets[i + 1] += result.offsets[i];
+        }
+
+        result.dests.resize(dests.size());
+        result.weights.resize(weights.size());
+        std::vector<int> pos(result.offsets.begin(), result.offsets.end() - 1);
+        for (int u = 0; u < numVertices; u++) {
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                int p = pos[dests[i]]++;
+                result.dests[p] = u;
+                result.weights[p] = weights[i];
+            }
+        }
+        return result;
+    }
+
+    // Merge out- and in-edges, keeping one edge per pair (the first weight seen)
+    CSRGraph CSRGraph::symmetrized() const {
+        if (!directed) {
+            return *this;
+        }
+        const CSRGraph reverse = transposed();
+        CSRGraph result(numVertices, false);
+        std::vector<int> seen(numVertices, -1);
+        for (int u = 0; u < numVertices; u++) {
+            for (const CSRGraph* side : {this, &reverse}) {
+                for (int i = side->offsets[u]; i < side->offsets[u + 1]; i++) {
+                    int v = side->dests[i];
+                    if (seen[v] != u) {
+                        seen[v] = u;
+                        result.dests.push_back(v);
+                        result.weights.push_back(side->weights[i]);
+                    }
+                }
+            }
+            result.offsets[u + 1] = static_cast<int>(result.dests.size());
+        }
+        return result;
+    }
+
+    // Label components on `threads` workers (0 = all cores)
+    std::vector<int> CSRGraph::connectedComponents(unsigned int threads) const {
+        return connectedComponentLabels(numVertices, !directed, threads,
+            [this](int u, int skip, int limit, const auto& visit) {
+                int end = offsets[u + 1];
+                if (limit < end - offsets[u]) {
+                    end = offsets[u] + limit;
+                }
+                for (int i = offsets[u] + skip; i < end; i++) {
+                    visit(dests[i]);
+                }
+            });
+    }
+
+} // namespace graph
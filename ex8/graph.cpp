@@ -1,14 +1,205 @@
 #include "graph.hpp"
+#include "connected_components.hpp"
+#include "work_stealing_pool.hpp"
 #include <iostream>
 #include <vector>
 #include <algorithm>
 #include <random>
-#include <set>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <new>
 
 namespace graph {
     
+    // Smallest block the arena grows by
+    static const std::size_t MIN_ARENA_BLOCK = 64;
+    
+    // Arena constructor
+    NeighborArena::NeighborArena(std::size_t capacity) : used(0), freeList(nullptr) {
+        if (capacity > 0) {
+            addBlock(capacity);
+        }
+    }
+    
+    // Arena move constructor
+    NeighborArena::NeighborArena(NeighborArena&& other) noexcept
+        : blocks(std::move(other.blocks)), used(other.used), freeList(other.freeList) {
+        other.blocks.clear();
+        other.used = 0;
+        other.freeList = nullptr;
+    }
+    
+    // Arena move assignment
+    NeighborArena& NeighborArena::operator=(NeighborArena&& other) noexcept {
+        if (this != &other) {
+            release();
+            blocks = std::move(other.blocks);
+            used = other.used;
+            freeList = other.freeList;
+            other.blocks.clear();
+            other.used = 0;
+            other.freeList = nullptr;
+        }
+        return *this;
+    }
+    
+    // Arena destructor
+    NeighborArena::~NeighborArena() {
+        release();
+    }
+    
+    // Grab a fresh block of raw storage
+    void NeighborArena::addBlock(std::size_t capacity) {
+        Neighbor* nodes = static_cast<Neighbor*>(::operator new(capacity * sizeof(Neighbor)));
+        blocks.push_back({nodes, capacity});
+        used = 0;
+    }
+    
+    // Allocate node - free list first, otherwise bump the current block
+    Neighbor* NeighborArena::allocate(int dest, int weight, Neighbor* next) {
+        Neighbor* slot;
+        if (freeList != nullptr) {
+            slot = freeList;
+            freeList = freeList->next;
+        } else {
+            if (blocks.empty() || used == blocks.back().capacity) {
+                std::size_t capacity = blocks.empty() ? MIN_ARENA_BLOCK : blocks.back().capacity * 2;
+                addBlock(capacity);
+            }
+            slot = blocks.back().nodes + used++;
+        }
+        return new (slot) Neighbor(dest, weight, next);
+    }
+    
+    // Return node to the free list
+    void NeighborArena::deallocate(Neighbor* node) {
+        node->next = freeList;
+        freeList = node;
+    }
+    
+    // Reserve room for a batch of allocations
+    void NeighborArena::reserve(std::size_t nodes) {
+        if (nodes == 0) {
+            return;
+        }
+        if (blocks.empty() || blocks.back().capacity - used < nodes) {
+            addBlock(std::max(nodes, MIN_ARENA_BLOCK));
+        }
+    }
+    
+    // Release every block at once (Neighbor is trivially destructible)
+    void NeighborArena::release() {
+        for (const Block& block : blocks) {
+            ::operator delete(block.nodes);
+        }
+        blocks.clear();
+        used = 0;
+        freeList = nullptr;
+    }
+    
+    namespace {
+    
+    // Open-addressing set of edge indices used while sampling random graphs
+    class EdgeIndexSet {
+    public:
+        explicit EdgeIndexSet(std::size_t expected) : mask(1) {
+            while (mask < 2 * expected) {
+                mask <<= 1;
+            }
+            slots.assign(mask, EMPTY);
+            mask -= 1;
+        }
+        
+        // Returns false if the index was already present
+        bool insert(std::uint64_t index) {
+            std::size_t slot = hash(index) & mask;
+            while (slots[slot] != EMPTY) {
+                if (slots[slot] == index) {
+                    return false;
+                }
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = index;
+            return true;
+        }
+        
+    private:
+        static constexpr std::uint64_t EMPTY = UINT64_MAX;
+        std::size_t mask;
+        std::vector<std::uint64_t> slots;
+        
+        static std::uint64_t hash(std::uint64_t x) {
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdULL;
+            x ^= x >> 33;
+            return x;
+        }
+    };
+    
+    } // namespace
+    
+    // Draw k distinct indices from [0, m) with Floyd's algorithm - O(k), no rejection loop
+    static std::vector<std::uint64_t> sampleDistinctIndices(std::uint64_t m, std::uint64_t k, std::mt19937_64& gen) {
+        std::vector<std::uint64_t> result;
+        result.reserve(k);
+        EdgeIndexSet chosen(k);
+        for (std::uint64_t j = m - k; j < m; j++) {
+            std::uniform_int_distribution<std::uint64_t> dis(0, j);
+            std::uint64_t t = dis(gen);
+            if (chosen.insert(t)) {
+                result.push_back(t);
+            } else {
+                chosen.insert(j);
+                result.push_back(j);
+            }
+        }
+        return result;
+    }
+    
+    // Work split for random generation: chunk count depends on the request
+    // only (never on the thread count) so every run yields the same graph
+    static const std::uint64_t EDGES_PER_CHUNK = 1 << 16;
+    static const std::uint64_t MAX_CHUNKS = 4096;
+    
+    // SplitMix64 - derives an independent RNG stream per chunk from the seed
+    static std::uint64_t splitMix64(std::uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+    
+    // Map an index of the upper triangle (row-major, u < v) back to its vertex pair
+    static std::pair<int, int> decodeEdgeIndex(std::uint64_t index, int vertices) {
+        double n = vertices;
+        double b = 2.0 * n - 1.0;
+        // Near the last rows of a huge graph rounding can push the
+        // discriminant just below zero; sqrt would then give NaN
+        double discriminant = std::max(0.0, b * b - 8.0 * static_cast<double>(index));
+        long long u = static_cast<long long>((b - std::sqrt(discriminant)) / 2.0);
+        auto rowStart = [vertices](long long row) {
+            return static_cast<std::uint64_t>(row) * (2 * static_cast<std::uint64_t>(vertices) - row - 1) / 2;
+        };
+        // Floating point may land one row off near the boundaries
+        if (u < 0) u = 0;
+        if (u > vertices - 1) u = vertices - 1;
+        while (u > 0 && rowStart(u) > index) u--;
+        while (u + 1 < vertices && rowStart(u + 1) <= index) u++;
+        int v = static_cast<int>(u + 1 + static_cast<long long>(index - rowStart(u)));
+        return {static_cast<int>(u), v};
+    }
+    
+    // Map an index of the V(V-1) ordered pairs (row-major, diagonal skipped) back to its arc
+    static std::pair<int, int> decodeArcIndex(std::uint64_t index, int vertices) {
+        std::uint64_t row = static_cast<std::uint64_t>(vertices) - 1;
+        int u = static_cast<int>(index / row);
+        int v = static_cast<int>(index % row);
+        return {u, v < u ? v : v + 1};
+    }
+    
     // Constructor
-    Graph::Graph(int n) : numVertices(n) {
+    Graph::Graph(int n, bool directed) : numVertices(n), numEdges(0), directed(directed) {
         if (n <= 0) {
             throw std::invalid_argument("Number of vertices must be positive");
         }
@@ -16,17 +207,23 @@ namespace graph {
         for (int i = 0; i < n; i++) {
             adjList[i] = nullptr;
         }
+        degrees.assign(n, 0);
+        if (directed) {
+            inDegrees.assign(n, 0);
+        }
     }
     
     // Copy constructor  
-    Graph::Graph(const Graph& other) : numVertices(other.numVertices) {
+    Graph::Graph(const Graph& other)
+        : numVertices(other.numVertices), arena((other.directed ? 1 : 2) * other.numEdges), degrees(other.degrees),
+          inDegrees(other.inDegrees), numEdges(other.numEdges), directed(other.directed) {
         adjList = new Neighbor*[numVertices];
         for (int i = 0; i < numVertices; i++) {
             adjList[i] = nullptr;
             Neighbor* current = other.adjList[i];
             Neighbor** tail = &adjList[i];
             while (current != nullptr) {
-                *tail = new Neighbor(current->dest, current->weight);
+                *tail = arena.allocate(current->dest, current->weight);
                 tail = &((*tail)->next);
                 current = current->next;
             }
@@ -36,25 +233,23 @@ namespace graph {
     // Assignment operator
     Graph& Graph::operator=(const Graph& other) {
         if (this != &other) {
-            for (int i = 0; i < numVertices; i++) {
-                Neighbor* current = adjList[i];
-                while (current != nullptr) {
-                    Neighbor* temp = current;
-                    current = current->next;
-                    delete temp;
-                }
-            }
+            arena.release();
             delete[] adjList;
             
             numVertices = other.numVertices;
             adjList = new Neighbor*[numVertices];
+            arena.reserve((other.directed ? 1 : 2) * other.numEdges);
+            degrees = other.degrees;
+            inDegrees = other.inDegrees;
+            numEdges = other.numEdges;
+            directed = other.directed;
             
             for (int i = 0; i < numVertices; i++) {
                 adjList[i] = nullptr;
                 Neighbor* current = other.adjList[i];
                 Neighbor** tail = &adjList[i];
                 while (current != nullptr) {
-                    *tail = new Neighbor(current->dest, current->weight);
+                    *tail = arena.allocate(current->dest, current->weight);
                     tail = &((*tail)->next);
                     current = current->next;
                 }
@@ -63,6 +258,38 @@ namespace graph {
         return *this;
     }
     
+    // Move constructor
+    Graph::Graph(Graph&& other) noexcept
+        : numVertices(other.numVertices), adjList(other.adjList), arena(std::move(other.arena)),
+          degrees(std::move(other.degrees)), inDegrees(std::move(other.inDegrees)), numEdges(other.numEdges),
+          directed(other.directed) {
+        other.numVertices = 0;
+        other.adjList = nullptr;
+        other.degrees.clear();
+        other.inDegrees.clear();
+        other.numEdges = 0;
+    }
+    
+    // Move assignment
+    Graph& Graph::operator=(Graph&& other) noexcept {
+        if (this != &other) {
+            delete[] adjList;
+            numVertices = other.numVertices;
+            adjList = other.adjList;
+            arena = std::move(other.arena);
+            degrees = std::move(other.degrees);
+            inDegrees = std::move(other.inDegrees);
+            numEdges = other.numEdges;
+            directed = other.directed;
+            other.numVertices = 0;
+            other.adjList = nullptr;
+            other.degrees.clear();
+            other.inDegrees.clear();
+            other.numEdges = 0;
+        }
+        return *this;
+    }
+    
     // Add edge
     void Graph::addEdge(int src, int dest, int weight) {
         if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) {
@@ -80,6 +307,9 @@ namespace graph {
             if (current != nullptr) {
                 current->weight = weight;
             }
+            if (directed) {
+                return;
+            }
             current = adjList[dest];
             while (current != nullptr && current->dest != src) {
                 current = current->next;
@@ -88,11 +318,23 @@ namespace graph {
                 current->weight = weight;
             }
         } else {
-            adjList[src] = new Neighbor(dest, weight, adjList[src]);
-            adjList[dest] = new Neighbor(src, weight, adjList[dest]);
+            addEdgeUnchecked(src, dest, weight);
         }
     }
     
+    // Add edge without the duplicate scan - caller guarantees a new, valid edge
+    void Graph::addEdgeUnchecked(int src, int dest, int weight) {
+        adjList[src] = arena.allocate(dest, weight, adjList[src]);
+        degrees[src]++;
+        numEdges++;
+        if (directed) {
+            inDegrees[dest]++;
+            return;
+        }
+        adjList[dest] = arena.allocate(src, weight, adjList[dest]);
+        degrees[dest]++;
+    }
+    
     // Remove edge
     void Graph::removeEdge(int src, int dest) {
         if (src < 0 || src >= numVertices || dest < 0 || dest >= numVertices) {
@@ -107,22 +349,29 @@ namespace graph {
             if ((*current)->dest == dest) {
                 Neighbor* temp = *current;
                 *current = (*current)->next;
-                delete temp;
+                arena.deallocate(temp);
                 break;
             }
             current = &((*current)->next);
         }
+        degrees[src]--;
+        numEdges--;
+        if (directed) {
+            inDegrees[dest]--;
+            return;
+        }
         
         current = &adjList[dest];
         while (*current != nullptr) {
             if ((*current)->dest == src) {
                 Neighbor* temp = *current;
                 *current = (*current)->next;
-                delete temp;
+                arena.deallocate(temp);
                 break;
             }
             current = &((*current)->next);
         }
+        degrees[dest]--;
     }
     
     // Print graph
@@ -181,98 +430,93 @@ namespace graph {
         throw std::runtime_error("Edge not found");
     }
     
-    // Get degree
+    // Get degree - O(1), cached
     int Graph::getDegree(int vertex) const {
         if (vertex < 0 || vertex >= numVertices) {
             throw std::out_of_range("Vertex index out of range");
         }
-        int degree = 0;
-        Neighbor* current = adjList[vertex];
-        while (current != nullptr) {
-            degree++;
-            current = current->next;
+        return degrees[vertex];
+    }
+    
+    // Get in-degree - O(1), cached; same as the degree when undirected
+    int Graph::getInDegree(int vertex) const {
+        if (vertex < 0 || vertex >= numVertices) {
+            throw std::out_of_range("Vertex index out of range");
         }
-        return degree;
+        return directed ? inDegrees[vertex] : degrees[vertex];
     }
     
-    // Get number of edges
+    // Get number of edges - O(1), cached
     int Graph::getNumEdges() const {
-        int edges = 0;
-        for (int i = 0; i < numVertices; i++) {
-            Neighbor* current = adjList[i];
-            while (current != nullptr) {
-                edges++;
-                current = current->next;
-            }
-        }
-        return edges / 2;
+        return numEdges;
     }
     
-    // DFS helper
-    void Graph::dfs(int vertex, std::vector<bool>& visited) const {
-        visited[vertex] = true;
-        Neighbor* current = adjList[vertex];
-        while (current != nullptr) {
-            if (!visited[current->dest]) {
-                dfs(current->dest, visited);
-            }
-            current = current->next;
-        }
+    // Check edge orientation
+    bool Graph::isDirected() const {
+        return directed;
     }
     
-    // Check connectivity
-    bool Graph::isConnected() const {
-        int start = -1;
+    // Component label of every vertex (its smallest member), on `threads` workers
+    std::vector<int> Graph::connectedComponents(unsigned int threads) const {
+        return connectedComponentLabels(numVertices, !directed, threads,
+            [this](int u, int skip, int limit, const auto& visit) {
+                Neighbor* current = adjList[u];
+                for (int i = 0; i < skip && current != nullptr; i++) {
+                    current = current->next;
+                }
+                for (int i = skip; i < limit && current != nullptr; i++) {
+                    visit(current->dest);
+                    current = current->next;
+                }
+            });
+    }
+    
+    // Check connectivity - every vertex with an edge lies in one component
+    // (weakly connected for directed graphs)
+    bool Graph::isConnected(unsigned int threads) const {
+        int touched = 0;
         for (int i = 0; i < numVertices; i++) {
-            if (getDegree(i) > 0) {
-                start = i;
-                break;
+            if (degrees[i] > 0 || (directed && inDegrees[i] > 0)) {
+                touched++;
             }
         }
-        if (start == -1) {
+        // Spanning the touched vertices takes at least touched - 1 edges
+        if (numEdges < touched - 1) {
+            return false;
+        }
+        if (numEdges == 0) {
             return true;
         }
         
-        std::vector<bool> visited(numVertices, false);
-        dfs(start, visited);
-        
+        std::vector<int> label = connectedComponents(threads);
+        int component = -1;
         for (int i = 0; i < numVertices; i++) {
-            if (getDegree(i) > 0 && !visited[i]) {
-                return false;
+            if (degrees[i] > 0 || (directed && inDegrees[i] > 0)) {
+                if (component == -1) {
+                    component = label[i];
+                } else if (label[i] != component) {
+                    return false;
+                }
             }
         }
         return true;
     }
     
-    // Check Euler circuit
-    bool Graph::hasEulerCircuit() const {
-        if (!isConnected()) {
-            return false;
-        }
+    // Check Euler circuit - the O(V) degree test first, connectivity only if it passes
+    bool Graph::hasEulerCircuit(unsigned int threads) const {
+        // A balanced, weakly connected digraph is strongly connected
         for (int i = 0; i < numVertices; i++) {
-            if (getDegree(i) % 2 != 0) {
+            if (directed ? degrees[i] != inDegrees[i] : degrees[i] % 2 != 0) {
                 return false;
             }
         }
-        return true;
+        return isConnected(threads);
     }
     
-    // Hierholzer DFS
-    void Graph::hierholzerDFS(int vertex, std::vector<int>& circuit, Graph& tempGraph) const {
-        while (tempGraph.getDegree(vertex) > 0) {
-            Neighbor* neighbor = tempGraph.getNeighbors(vertex);
-            if (neighbor == nullptr) break;
-            int next = neighbor->dest;
-            tempGraph.removeEdge(vertex, next);
-            hierholzerDFS(next, circuit, tempGraph);
-        }
-        circuit.push_back(vertex);
-    }
-    
-    // Find Euler circuit
-    std::vector<int> Graph::findEulerCircuit() const {
+    // Find Euler circuit - iterative Hierholzer, O(V + E), no graph copy
+    std::vector<int> Graph::findEulerCircuit(unsigned int threads) const {
         std::vector<int> circuit;
-        if (!hasEulerCircuit()) {
+        if (!hasEulerCircuit(threads)) {
             return circuit;
         }
         
@@ -287,56 +531,193 @@ namespace graph {
             return circuit;
         }
         
-        Graph tempGraph(*this);
-        hierholzerDFS(start, circuit, tempGraph);
+        // Flatten the lists (keeping their order) and give both halves of
+        // every edge the same id. Half-edge x -> y with x < y mints the id and
+        // leaves it in y's pending bucket; y picks it up before walking its list.
+        // Directed arcs have no other half, so each one is its own id.
+        std::vector<int> first(numVertices + 1, 0);
+        for (int i = 0; i < numVertices; i++) {
+            first[i + 1] = first[i] + degrees[i];
+        }
+        std::vector<int> to(first[numVertices]);
+        std::vector<int> edgeId(first[numVertices]);
+        std::vector<int> pendingFrom(directed ? 0 : first[numVertices]);
+        std::vector<int> pendingId(directed ? 0 : first[numVertices]);
+        std::vector<int> pendingFill(first.begin(), first.end() - 1);
+        std::vector<int> idFrom(numVertices);
+        int nextId = 0;
+        
+        for (int x = 0; x < numVertices; x++) {
+            for (int p = first[x]; p < pendingFill[x]; p++) {
+                idFrom[pendingFrom[p]] = pendingId[p];
+            }
+            int pos = first[x];
+            for (Neighbor* current = adjList[x]; current != nullptr; current = current->next) {
+                int y = current->dest;
+                to[pos] = y;
+                if (directed) {
+                    edgeId[pos] = nextId++;
+                } else if (x < y) {
+                    edgeId[pos] = nextId;
+                    pendingFrom[pendingFill[y]] = x;
+                    pendingId[pendingFill[y]] = nextId;
+                    pendingFill[y]++;
+                    nextId++;
+                } else {
+                    edgeId[pos] = idFrom[y];
+                }
+                pos++;
+            }
+        }
+        
+        // Walk with per-vertex cursors; an edge is consumed from either end
+        std::vector<int> cursor(first.begin(), first.end() - 1);
+        std::vector<bool> used(nextId, false);
+        std::vector<int> stack;
+        stack.push_back(start);
+        circuit.reserve(numEdges + 1);
+        
+        while (!stack.empty()) {
+            int vertex = stack.back();
+            int& c = cursor[vertex];
+            while (c < first[vertex + 1] && used[edgeId[c]]) {
+                c++;
+            }
+            if (c == first[vertex + 1]) {
+                circuit.push_back(vertex);
+                stack.pop_back();
+            } else {
+                used[edgeId[c]] = true;
+                stack.push_back(to[c]);
+                c++;
+            }
+        }
         std::reverse(circuit.begin(), circuit.end());
         return circuit;
     }
     
     // Generate random graph
-    Graph Graph::generateRandomGraph(int vertices, int edges, unsigned int seed) {
-        Graph graph(vertices);
-        std::mt19937 gen(seed);
-        std::uniform_int_distribution<> dis(0, vertices - 1);
+    Graph Graph::generateRandomGraph(int vertices, int edges, unsigned int seed, unsigned int threads, bool directed) {
+        Graph graph(vertices, directed);
+        graph.addRandomEdges(edges, seed, threads);
+        return graph;
+    }
+    
+    // Generate random graph into a heap allocation (no temporary to copy or move)
+    std::unique_ptr<Graph> Graph::createRandomGraph(int vertices, int edges, unsigned int seed, unsigned int threads,
+                                                    bool directed) {
+        std::unique_ptr<Graph> graph = std::make_unique<Graph>(vertices, directed);
+        graph->addRandomEdges(edges, seed, threads);
+        return graph;
+    }
+    
+    // Fill this graph with the seeded random edge sequence
+    void Graph::addRandomEdges(int edges, unsigned int seed, unsigned int threads) {
+        std::vector<std::pair<int, int>> edgeList = generateRandomEdges(numVertices, edges, seed, threads, directed);
+        arena.reserve((directed ? 1 : 2) * edgeList.size());
+        for (const auto& edge : edgeList) {
+            addEdgeUnchecked(edge.first, edge.second, 1);
+        }
+    }
+    
+    // Generate random distinct edges (u < v; any u != v when directed) in
+    // insertion order. Edges are indices of the V(V-1)/2 upper triangle (or
+    // the V(V-1) ordered pairs), split into contiguous chunks. A master RNG
+    // decides how many edges land in each chunk, then each chunk samples its
+    // own slice with a private stream - in parallel, writing to a precomputed
+    // offset. Dense chunks sample their complement instead.
+    std::vector<std::pair<int, int>> Graph::generateRandomEdges(int vertices, int edges, unsigned int seed,
+                                                                unsigned int threads, bool directed) {
+        if (vertices <= 0) {
+            throw std::invalid_argument("Number of vertices must be positive");
+        }
+        std::vector<std::pair<int, int>> result;
+        if (edges <= 0) {
+            return result;
+        }
         
-        int edgesAdded = 0;
-        int maxPossibleEdges = (vertices * (vertices - 1)) / 2;
-        if (edges > maxPossibleEdges) {
-            edges = maxPossibleEdges;
+        std::uint64_t maxPossibleEdges = static_cast<std::uint64_t>(vertices) * (vertices - 1) / (directed ? 1 : 2);
+        auto decode = directed ? decodeArcIndex : decodeEdgeIndex;
+        std::uint64_t wanted = std::min<std::uint64_t>(edges, maxPossibleEdges);
+        if (wanted == 0) {
+            return result;
         }
         
-        std::set<std::pair<int, int>> edgeSet;
-        while (edgesAdded < edges) {
-            int u = dis(gen);
-            int v = dis(gen);
-            if (u != v) {
-                if (u > v) std::swap(u, v);
-                if (edgeSet.find({u, v}) == edgeSet.end()) {
-                    graph.addEdge(u, v);
-                    edgeSet.insert({u, v});
-                    edgesAdded++;
+        std::uint64_t numChunks = (wanted + EDGES_PER_CHUNK - 1) / EDGES_PER_CHUNK;
+        numChunks = std::min(numChunks, std::min(MAX_CHUNKS, maxPossibleEdges));
+        std::uint64_t chunkSize = (maxPossibleEdges + numChunks - 1) / numChunks;
+        numChunks = (maxPossibleEdges + chunkSize - 1) / chunkSize;
+        
+        // Edge count per chunk: binomial share of what is left, clamped so the
+        // remaining chunks can always absorb the rest (the last one takes it all)
+        std::vector<std::uint64_t> chunkEdges(numChunks);
+        std::vector<std::uint64_t> chunkOffset(numChunks + 1, 0);
+        std::mt19937_64 master(seed);
+        std::uint64_t remainingEdges = wanted;
+        std::uint64_t remainingSlots = maxPossibleEdges;
+        for (std::uint64_t c = 0; c < numChunks; c++) {
+            std::uint64_t size = std::min(chunkSize, remainingSlots);
+            std::binomial_distribution<long long> share(static_cast<long long>(remainingEdges),
+                                                        static_cast<double>(size) / static_cast<double>(remainingSlots));
+            std::uint64_t count = static_cast<std::uint64_t>(share(master));
+            std::uint64_t low = remainingEdges > remainingSlots - size ? remainingEdges - (remainingSlots - size) : 0;
+            count = std::max(low, std::min(count, std::min(size, remainingEdges)));
+            chunkEdges[c] = count;
+            chunkOffset[c + 1] = chunkOffset[c] + count;
+            remainingEdges -= count;
+            remainingSlots -= size;
+        }
+        
+        result.resize(wanted);
+        auto sampleChunk = [&](std::uint64_t c) {
+            std::uint64_t lo = c * chunkSize;
+            std::uint64_t size = std::min(chunkSize, maxPossibleEdges - lo);
+            std::uint64_t count = chunkEdges[c];
+            std::pair<int, int>* out = result.data() + chunkOffset[c];
+            std::mt19937_64 gen(splitMix64(static_cast<std::uint64_t>(seed) * MAX_CHUNKS + c));
+            
+            if (count <= size / 2) {
+                for (std::uint64_t index : sampleDistinctIndices(size, count, gen)) {
+                    *out++ = decode(lo + index, vertices);
+                }
+            } else {
+                std::vector<std::uint64_t> excluded = sampleDistinctIndices(size, size - count, gen);
+                std::sort(excluded.begin(), excluded.end());
+                std::pair<int, int> pair = decode(lo, vertices);
+                std::size_t next = 0;
+                for (std::uint64_t index = 0; index < size; index++) {
+                    if (next < excluded.size() && excluded[next] == index) {
+                        next++;
+                    } else {
+                        *out++ = pair;
+                    }
+                    pair.second++;
+                    if (directed && pair.second == pair.first) {
+                        pair.second++;
+                    }
+                    if (pair.second == vertices) {
+                        pair.first++;
+                        pair.second = directed ? 0 : pair.first + 1;
+                    }
                 }
             }
-        }
-        return graph;
+        };
+        
+        // A single chunk stays on the calling thread
+        WorkStealingPool pool(threads);
+        pool.run(numChunks, [&](size_t c, unsigned int) { sampleChunk(c); });
+        return result;
     }
     
     // Display
     void Graph::display() const {
-        std::cout << "Graph with " << numVertices << " vertices and " << getNumEdges() << " edges:\n";
+        std::cout << (directed ? "Directed graph with " : "Graph with ") << numVertices << " vertices and " << getNumEdges() << " edges:\n";
         print_graph();
     }
     
     // Destructor
+    // Neighbor nodes are released in bulk by the arena
     Graph::~Graph() {
-        for (int i = 0; i < numVertices; i++) {
-            Neighbor* current = adjList[i];
-            while (current != nullptr) {
-                Neighbor* temp = current;
-                current = current->next;
-                delete temp;
-            }
-        }
         delete[] adjList;
     }
     
@@ -1,7 +1,12 @@
 #pragma once
 #include "graph.hpp"
+#include "csr_graph.hpp"
+#include "algorithm_result.hpp"
+#include "workspace.hpp"
+#include "cancellation.hpp"
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace graph {
 
@@ -9,7 +14,25 @@ namespace graph {
 class GraphAlgorithm {
 public:
     virtual ~GraphAlgorithm() = default;
-    virtual std::string execute(const Graph& graph) = 0;
+    // Typed result; serialize it (appendText/appendBinary) when responding.
+    // Scratch arrays are borrowed from workspace, which the calling thread owns.
+    // Engines without a near-linear bound (max flow, max clique) poll cancel
+    // and return their best result so far, marked partial, once it fires.
+    virtual AlgorithmResult compute(const CSRGraph& graph, Workspace& workspace, const CancellationToken& cancel) = 0;
+    // Without a time budget
+    AlgorithmResult compute(const CSRGraph& graph, Workspace& workspace) {
+        CancellationToken never;
+        return compute(graph, workspace, never);
+    }
+    // One-off call with a throwaway workspace
+    AlgorithmResult compute(const CSRGraph& graph) {
+        Workspace workspace;
+        return compute(graph, workspace);
+    }
+    // Convenience overloads returning the text form
+    std::string execute(const CSRGraph& graph) { return toText(compute(graph)); }
+    // Snapshots the linked-list graph into CSR first
+    std::string execute(const Graph& graph) { return execute(CSRGraph(graph)); }
     virtual std::string getName() const = 0;
 };
 
@@ -18,12 +41,49 @@ class AlgorithmFactory {
 public:
     enum class AlgorithmType {
         MST_WEIGHT,
+        MST_KRUSKAL,    // Spanning forest weight, radix-sorted Kruskal
+        MST_BORUVKA,    // Spanning forest weight, parallel Borůvka
         SCC,
         MAX_FLOW,
+        MAX_FLOW_PR,    // Same result as MAX_FLOW, push-relabel engine
         MAX_CLIQUE
     };
     
-    static std::unique_ptr<GraphAlgorithm> createAlgorithm(AlgorithmType type);
+    // Problem an engine solves; the pipeline runs one engine per problem
+    enum class Problem {
+        SPANNING_TREE,
+        SCC,
+        MAX_FLOW,
+        MAX_CLIQUE
+    };
+    
+    // Registry entry, one per AlgorithmType and in the same order
+    struct AlgorithmInfo {
+        AlgorithmType type;
+        const char* key;      // Request name, e.g. "MST_KRUSKAL"
+        const char* title;    // Display name, as returned by getName()
+        Problem problem;
+        bool preferred;       // Engine for its problem when the request names no other
+    };
+    
+    static const std::vector<AlgorithmInfo>& registry();
+    static const AlgorithmInfo& info(AlgorithmType type);
+    // Look up a request name; nullptr if unknown
+    static const AlgorithmInfo* find(const std::string& key);
+    // The requested engine if it solves `problem`, otherwise the preferred one
+    static AlgorithmType select(Problem problem, const std::string& requested);
+    // Comma-separated request names, for usage and error messages
+    static std::string availableNames();
+    
+    // Run an engine on a stack instance: no allocation and no virtual call.
+    // Long-lived threads pass their own workspace so scratch memory is reused.
+    static AlgorithmResult run(AlgorithmType type, const CSRGraph& graph, Workspace& workspace,
+                               const CancellationToken& cancel, unsigned int threads = 1);
+    static AlgorithmResult run(AlgorithmType type, const CSRGraph& graph, Workspace& workspace, unsigned int threads = 1);
+    static AlgorithmResult run(AlgorithmType type, const CSRGraph& graph, unsigned int threads = 1);
+    
+    // threads: workers for algorithms that run in parallel (MAX_CLIQUE, MST_BORUVKA), 0 = all cores
+    static std::unique_ptr<GraphAlgorithm> createAlgorithm(AlgorithmType type, unsigned int threads = 1);
     static std::string getAlgorithmName(AlgorithmType type);
 };
 
@@ -0,0 +1,43 @@
+#pragma once
+#include <csignal>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace graph {
+
+// Socket front end of a request/response server: accepts connections,
+// frames one request per connection, hands it to a callback and, once
+// respond() is called - from any thread - sends the response and closes
+// the connection. All socket I/O happens on the thread inside run().
+class IoEngine {
+public:
+    enum class Backend { EPOLL, IO_URING };
+
+    // Runs on the engine thread for every framed request. The connection
+    // belongs to the caller until respond() is called for client_fd.
+    using RequestHandler = std::function<void(int client_fd, const std::string& client_ip, std::string request)>;
+
+    // Longest request kept; anything longer is cut here, as the old 1 KB read did
+    static constexpr size_t MAX_REQUEST_BYTES = 1023;
+
+    virtual ~IoEngine() = default;
+
+    // Serve connections until running drops to 0
+    virtual void run(const volatile sig_atomic_t& running) = 0;
+
+    // Thread-safe: send response on client_fd, then close it
+    virtual void respond(int client_fd, std::string response) = 0;
+
+    virtual const char* name() const = 0;
+
+    // The preferred backend when this kernel supports it, else epoll.
+    // listen_fd must already be listening; throws std::runtime_error when
+    // not even epoll can be set up.
+    static std::unique_ptr<IoEngine> create(Backend preferred, int listen_fd, RequestHandler onRequest);
+};
+
+// Parse "epoll" or "uring"
+bool parseBackend(const std::string& text, IoEngine::Backend& backend);
+
+} // namespace graph
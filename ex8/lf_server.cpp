@@ -12,18 +12,25 @@
 #include <algorithm>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>  // For Leader-Follower synchronization
 #include <queue>              // For work queue
+#include <sstream>
+#include <functional>
 #include "graph.hpp"
 #include "graph_algorithm.hpp"
+#include "io_engine.hpp"
 
-#define BACKLOG 5
+#define BACKLOG SOMAXCONN
 #define THREAD_POOL_SIZE 4    // Fixed number of worker threads
 
 // Global variables for server control
 volatile sig_atomic_t running = 1;
-int listen_socket_fd = -1;
+
+// Hands a finished response for client_fd back to the I/O engine, which
+// sends it and closes the connection; callable from any worker thread
+using ResponseSink = std::function<void(int client_fd, std::string response)>;
 
 void analyzeGraph(const graph::Graph& g) {
     std::cout << "\n" << std::string(50, '=') << "\n";
@@ -33,32 +40,41 @@ void analyzeGraph(const graph::Graph& g) {
     g.display();
     
     std::cout << "\nVertex degrees:\n";
-    bool allEven = true;
+    bool allEven = true;  // Directed: every in-degree matches its out-degree
     for (int i = 0; i < g.getNumVertices(); i++) {
         int degree = g.getDegree(i);
-        std::cout << "Vertex " << i << ": degree " << degree;
-        if (degree % 2 != 0) {
-            std::cout << " (odd)";
-            allEven = false;
-        } else if (degree > 0) {
-            std::cout << " (even)";
+        if (g.isDirected()) {
+            int inDegree = g.getInDegree(i);
+            std::cout << "Vertex " << i << ": out-degree " << degree << ", in-degree " << inDegree;
+            if (degree != inDegree) {
+                std::cout << " (unbalanced)";
+                allEven = false;
+            }
+        } else {
+            std::cout << "Vertex " << i << ": degree " << degree;
+            if (degree % 2 != 0) {
+                std::cout << " (odd)";
+                allEven = false;
+            } else if (degree > 0) {
+                std::cout << " (even)";
+            }
         }
         std::cout << "\n";
     }
     
-    std::cout << "\nConnectivity: " << (g.isConnected() ? "Connected" : "Disconnected") << "\n";
-    std::cout << "All degrees even: " << (allEven ? "Yes" : "No") << "\n";
+    std::cout << "\nConnectivity: " << (g.isConnected(0) ? "Connected" : "Disconnected") << "\n";
+    std::cout << (g.isDirected() ? "All vertices balanced: " : "All degrees even: ") << (allEven ? "Yes" : "No") << "\n";
     
     std::cout << "\n" << std::string(30, '-') << "\n";
     std::cout << "EULER CIRCUIT ANALYSIS\n";
     std::cout << std::string(30, '-') << "\n";
     
-    if (g.hasEulerCircuit()) {
+    if (g.hasEulerCircuit(0)) {
         std::cout << "✓ Euler circuit EXISTS!\n";
         std::cout << "Finding Euler circuit...\n";
         
         auto start = std::chrono::high_resolution_clock::now();
-        std::vector<int> circuit = g.findEulerCircuit();
+        std::vector<int> circuit = g.findEulerCircuit(0);
         auto end = std::chrono::high_resolution_clock::now();
         
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
@@ -73,20 +89,31 @@ void analyzeGraph(const graph::Graph& g) {
         std::cout << "Circuit length: " << circuit.size() << " vertices\n";
     } else {
         std::cout << "✗ No Euler circuit exists\n";
-        if (!g.isConnected()) {
+        if (!g.isConnected(0)) {
             std::cout << "Reason: Graph is not connected\n";
         } else if (!allEven) {
-            std::cout << "Reason: Not all vertices have even degree\n";
+            std::cout << (g.isDirected() ? "Reason: Some in-degree differs from its out-degree\n"
+                                         : "Reason: Not all vertices have even degree\n");
         }
     }
     
     std::cout << std::string(50, '=') << "\n";
 }
 
-std::string processGraphRequest(const std::string &request)
+// Cores for one leader-follower worker. All THREAD_POOL_SIZE workers may
+// be computing at once, so each gets an even share instead of every core
+unsigned int workerThreadShare()
 {
-    // Parse request like "-e 5 -v 4 -s 43 -a MST_WEIGHT"
-    int edges = -1, vertices = -1, seed = -1;
+    static const unsigned int share = std::max(1u, std::thread::hardware_concurrency() / THREAD_POOL_SIZE);
+    return share;
+}
+
+std::string processGraphRequest(const std::string &request, graph::Workspace &workspace)
+{
+    // Parse request like "-e 5 -v 4 -s 43 -a MST_WEIGHT" (add -d for a directed
+    // graph, -t <ms> to bound the algorithm's running time)
+    int edges = -1, vertices = -1, seed = -1, budget = 0;
+    bool directed = false;
     std::string algorithm = "EULER"; // Default to Euler circuit
 
     // Parse parameters
@@ -111,27 +138,49 @@ std::string processGraphRequest(const std::string &request)
     pos = request.find("-a ");
     if (pos != std::string::npos)
     {
-        algorithm = request.substr(pos + 3);
+        std::istringstream(request.substr(pos + 3)) >> algorithm;
+    }
+
+    std::istringstream tokens(request);
+    std::string token;
+    while (tokens >> token)
+    {
+        if (token == "-d")
+        {
+            directed = true;
+        }
+        else if (token == "-t")
+        {
+            if (!(tokens >> budget) || budget <= 0)
+            {
+                budget = -1;
+            }
+        }
     }
 
-    if (edges < 0 || vertices <= 0)
+    if (edges < 0 || vertices <= 0 || budget < 0)
     {
-        return "ERROR: Invalid parameters. Use format: -e <edges> -v <vertices> -s <seed> [-a <algorithm>]\n"
-               "Available algorithms: EULER, MST_WEIGHT, SCC, MAX_FLOW, MAX_CLIQUE";
+        return "ERROR: Invalid parameters. Use format: -e <edges> -v <vertices> -s <seed> [-a <algorithm>] [-d] [-t <ms>]\n"
+               "Available algorithms: EULER, " + graph::AlgorithmFactory::availableNames();
     }
 
     try
     {
+        // The budget starts counting before the graph is built
+        graph::CancellationToken cancel = budget > 0 ? graph::CancellationToken(std::chrono::milliseconds(budget))
+                                                     : graph::CancellationToken();
+        
         // Generate random graph
-        graph::Graph graph = graph::Graph::generateRandomGraph(vertices, edges, seed);
+        unsigned int threads = workerThreadShare();
+        graph::Graph graph = graph::Graph::generateRandomGraph(vertices, edges, seed, threads, directed);
         
         std::string result;
         
         if (algorithm == "EULER" || algorithm == "EULER_CIRCUIT") {
             // Original Euler circuit logic
-            if (graph.hasEulerCircuit())
+            if (graph.hasEulerCircuit(threads))
             {
-                std::vector<int> circuit = graph.findEulerCircuit();
+                std::vector<int> circuit = graph.findEulerCircuit(threads);
                 result = "SUCCESS: Graph has Euler circuit!\n";
                 result += "Vertices: " + std::to_string(vertices) + "\n";
                 result += "Edges: " + std::to_string(edges) + "\n";
@@ -149,35 +198,25 @@ std::string processGraphRequest(const std::string &request)
                 result = "RESULT: Graph does NOT have Euler circuit\n";
                 result += "Vertices: " + std::to_string(vertices) + "\n";
                 result += "Edges: " + std::to_string(edges) + "\n";
-                result += "Reason: Graph is not connected or has odd-degree vertices";
+                result += directed ? "Reason: Graph is not connected or some in-degree differs from its out-degree"
+                                   : "Reason: Graph is not connected or has odd-degree vertices";
                 analyzeGraph(graph);
             }
         } else {
-            graph::AlgorithmFactory::AlgorithmType algoType;
-            
-            if (algorithm == "MST_WEIGHT") {
-                algoType = graph::AlgorithmFactory::AlgorithmType::MST_WEIGHT;
-            } else if (algorithm == "SCC") {
-                algoType = graph::AlgorithmFactory::AlgorithmType::SCC;
-            } else if (algorithm == "MAX_FLOW") {
-                algoType = graph::AlgorithmFactory::AlgorithmType::MAX_FLOW;
-            } else if (algorithm == "MAX_CLIQUE") {
-                algoType = graph::AlgorithmFactory::AlgorithmType::MAX_CLIQUE;
-            } else {
-                return "ERROR: Unknown algorithm '" + algorithm + "'. Available: EULER, MST_WEIGHT, SCC, MAX_FLOW, MAX_CLIQUE";
-            }
-            
-            auto algo = graph::AlgorithmFactory::createAlgorithm(algoType);
-            if (!algo) {
-                return "ERROR: Failed to create algorithm instance";
+            const graph::AlgorithmFactory::AlgorithmInfo* info = graph::AlgorithmFactory::find(algorithm);
+            if (info == nullptr) {
+                return "ERROR: Unknown algorithm '" + algorithm + "'. Available: EULER, " + graph::AlgorithmFactory::availableNames();
             }
             
-            result = "ALGORITHM: " + algo->getName() + "\n";
+            result = "ALGORITHM: " + std::string(info->title) + "\n";
             result += "Vertices: " + std::to_string(vertices) + "\n";
             result += "Edges: " + std::to_string(edges) + "\n";
             result += "Seed: " + std::to_string(seed) + "\n";
+            if (budget > 0) {
+                result += "Time budget: " + std::to_string(budget) + " ms\n";
+            }
             result += "Result:\n";
-            result += algo->execute(graph);
+            graph::appendText(result, graph::AlgorithmFactory::run(info->type, graph::CSRGraph(graph), workspace, cancel, threads));
 
             // Display graph info
             analyzeGraph(graph);
@@ -194,13 +233,14 @@ std::string processGraphRequest(const std::string &request)
 // Leader-Follower pattern implementation
 class LeaderFollowerServer {
 private:
-    // Work item structure - now only contains socket and IP, request is read by worker
+    // Work item structure - the I/O engine has already read the request
     struct WorkItem {
         int client_fd;
         std::string client_ip;
+        std::string request;
         
-        WorkItem(int fd, const std::string& ip) 
-            : client_fd(fd), client_ip(ip) {}
+        WorkItem(int fd, const std::string& ip, std::string req) 
+            : client_fd(fd), client_ip(ip), request(std::move(req)) {}
     };
     
     // Synchronization primitives for Leader-Follower pattern
@@ -214,9 +254,12 @@ private:
     std::vector<std::thread> thread_pool; // Fixed pool of worker threads
     bool leader_available;             // Flag indicating if leader role is available
     int current_leader_id;             // ID of current leader thread
+    ResponseSink respond;              // Sends a response and closes the connection
+    std::atomic<bool> shut_down{false}; // Set by the first shutdown()
     
 public:
-    LeaderFollowerServer() : leader_available(true), current_leader_id(-1) {
+    explicit LeaderFollowerServer(ResponseSink respond)
+        : leader_available(true), current_leader_id(-1), respond(std::move(respond)) {
         // Create fixed thread pool
         std::cout << "Creating Leader-Follower server with " << THREAD_POOL_SIZE << " threads\n";
         for (int i = 0; i < THREAD_POOL_SIZE; ++i) {
@@ -228,18 +271,22 @@ public:
         shutdown();
     }
     
-    // Add work item to the queue - only socket and IP, no pre-read request
-    void addWork(int client_fd, const std::string& client_ip) {
+    // Add a framed request to the queue
+    void addWork(int client_fd, const std::string& client_ip, std::string request) {
         {
             std::lock_guard<std::mutex> lock(work_queue_mutex);
-            work_queue.emplace(client_fd, client_ip);
+            work_queue.emplace(client_fd, client_ip, std::move(request));
             std::cout << "Added work to queue. Queue size: " << work_queue.size() << std::endl;
         }
         work_cv.notify_one(); // Wake up one waiting worker
     }
     
-    // Shutdown the server and join all threads
+    // Shutdown the server and join all threads; later calls, such as the
+    // destructor's after an explicit shutdown, do nothing
     void shutdown() {
+        if (shut_down.exchange(true)) {
+            return;
+        }
         std::cout << "Shutting down Leader-Follower server...\n";
         running = 0;
         work_cv.notify_all();   // Wake up all waiting workers
@@ -258,6 +305,7 @@ private:
     // Main function for each worker thread - implements Leader-Follower pattern
     void workerThread(int thread_id) {
         std::cout << "Worker thread " << thread_id << " started\n";
+        graph::Workspace workspace; // Scratch arrays reused across this thread's requests
         
         while (running) {
             // Step 1: Try to become the leader
@@ -276,7 +324,7 @@ private:
             std::cout << "Thread " << thread_id << " became LEADER\n";
             
             // Step 2: As leader, wait for work
-            WorkItem work_item(0, "");
+            WorkItem work_item(0, "", "");
             bool got_work = false;
             
             {
@@ -297,7 +345,7 @@ private:
                 
                 // Get work from queue
                 if (!work_queue.empty()) {
-                    work_item = work_queue.front();
+                    work_item = std::move(work_queue.front());
                     work_queue.pop();
                     got_work = true;
                     std::cout << "Thread " << thread_id << " got work. Queue size: " << work_queue.size() << std::endl;
@@ -316,46 +364,24 @@ private:
                 leader_cv.notify_one(); // Wake up another thread to become leader
                 
                 // Step 4: Process the work as follower
-                processRequest(thread_id, work_item);
+                processRequest(thread_id, work_item, workspace);
             }
         }
         
         std::cout << "Worker thread " << thread_id << " finished\n";
     }
     
-    // Process a single client request - now reads request from socket
-    void processRequest(int thread_id, const WorkItem& work_item) {
-        std::cout << "Thread " << thread_id << " handling connection from " << work_item.client_ip << std::endl;
+    // Process a single client request; the I/O engine sends the response
+    // and closes the connection
+    void processRequest(int thread_id, const WorkItem& work_item, graph::Workspace& workspace) {
+        std::cout << "Thread " << thread_id << " processing request from " 
+                  << work_item.client_ip << ": " << work_item.request << std::endl;
         
-        // Read request from client socket
-        char buffer[1024];
-        ssize_t bytes_received = recv(work_item.client_fd, buffer, sizeof(buffer) - 1, 0);
+        // Process the graph request using existing function
+        respond(work_item.client_fd, processGraphRequest(work_item.request, workspace));
         
-        if (bytes_received > 0) {
-            buffer[bytes_received] = '\0';
-            std::string request(buffer);
-            
-            std::cout << "Thread " << thread_id << " processing request from " 
-                      << work_item.client_ip << ": " << request << std::endl;
-            
-            // Process the graph request using existing function
-            std::string response = processGraphRequest(request);
-            
-            // Send response to client
-            if (send(work_item.client_fd, response.c_str(), response.length(), 0) < 0) {
-                perror("send");
-            }
-            
-            std::cout << "Thread " << thread_id << " completed processing for " 
-                      << work_item.client_ip << std::endl;
-        } else if (bytes_received == 0) {
-            std::cout << "Thread " << thread_id << " - Client " << work_item.client_ip << " disconnected before sending request\n";
-        } else {
-            perror("recv");
-        }
-        
-        // Close connection
-        close(work_item.client_fd);
+        std::cout << "Thread " << thread_id << " completed processing for " 
+                  << work_item.client_ip << std::endl;
     }
 };
 
@@ -368,16 +394,7 @@ void signal_handler(int sig)
     running = 0;
     std::cout << "\nReceived signal " << sig << ", shutting down server" << std::endl;
     
-    // Shutdown Leader-Follower server
-    if (lf_server) {
-        lf_server->shutdown();
-    }
-
-    if (listen_socket_fd != -1)
-    {
-        close(listen_socket_fd);
-        listen_socket_fd = -1;
-    }
+    // The I/O engine loop notices within 100 ms; main shuts the workers down
 }
 
 int main(int argc, char *argv[])
@@ -386,11 +403,13 @@ int main(int argc, char *argv[])
 
     // TCP Server setup
     int tcp_port;
+    graph::IoEngine::Backend backend = graph::IoEngine::Backend::EPOLL;
 
-    if (argc != 2)
+    if ((argc != 2 && argc != 4) ||
+        (argc == 4 && (std::string(argv[2]) != "-i" || !graph::parseBackend(argv[3], backend))))
     {
         std::cerr << "Error: Number of parameters is incorrect\n";
-        std::cerr << "Usage: " << argv[0] << " <port>\n";
+        std::cerr << "Usage: " << argv[0] << " <port> [-i <epoll|uring>]\n";
         return 1;
     }
     else
@@ -412,8 +431,6 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    listen_socket_fd = listen_fd;
-
     // Set socket options
     int opt = 1;
     setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
@@ -442,57 +459,31 @@ int main(int argc, char *argv[])
     std::cout << "Thread pool size: " << THREAD_POOL_SIZE << std::endl;
     std::cout << "Waiting for connections..." << std::endl;
 
-    // Initialize Leader-Follower server
-    lf_server = std::make_unique<LeaderFollowerServer>();
-
-    // Main accept loop - now only handles connection acceptance
-    while (running)
+    try
     {
-        // Use select to check for incoming connections with timeout
-        fd_set readfds;
-        FD_ZERO(&readfds);
-        FD_SET(listen_fd, &readfds);
-
-        struct timeval tv;
-        tv.tv_sec = 0;
-        tv.tv_usec = 100000; // 100ms timeout
-
-        int activity = select(listen_fd + 1, &readfds, NULL, NULL, &tv);
-
-        if (activity < 0)
-        {
-            if (running) perror("select");
-            continue;
-        }
-
-        if (!running)
-        {
-            break;
-        }
-
-        // Check if there's a new connection ready
-        if (activity == 0 || !FD_ISSET(listen_fd, &readfds))
-        {
-            continue;
-        }
-
-        // Accept new connection
-        struct sockaddr_in client_addr;
-        socklen_t client_len = sizeof(client_addr);
-        int client_fd = accept(listen_fd, (struct sockaddr *)&client_addr, &client_len);
+        // One I/O engine thread accepts, reads and writes; the Leader-Follower
+        // pool only sees complete requests and hands back complete responses
+        auto engine = graph::IoEngine::create(backend, listen_fd, [](int client_fd, const std::string& client_ip, std::string request) {
+            lf_server->addWork(client_fd, client_ip, std::move(request));
+        });
         
-        if (client_fd < 0)
-        {
-            perror("accept");
-            continue;
-        }
-
-        char client_ip[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &client_addr.sin_addr, client_ip, INET_ADDRSTRLEN);
-        std::cout << "New connection from " << client_ip << ":" << ntohs(client_addr.sin_port) << std::endl;
-
-        // Add work to Leader-Follower queue - socket will be read by worker thread
-        lf_server->addWork(client_fd, client_ip);
+        // Initialize Leader-Follower server
+        lf_server = std::make_unique<LeaderFollowerServer>([&engine](int client_fd, std::string response) {
+            engine->respond(client_fd, std::move(response));
+        });
+        
+        std::cout << "I/O engine: " << engine->name() << std::endl;
+        engine->run(running);
+        
+        // Stop the workers before the engine they respond through
+        lf_server->shutdown();
+        lf_server.reset();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        close(listen_fd);
+        return 1;
     }
 
     close(listen_fd);
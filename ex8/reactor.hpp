@@ -0,0 +1,62 @@
+#pragma once
+#include "io_engine.hpp"
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+// Single-threaded epoll front end.
+// Accepts, reads and frames requests without blocking, and writes each
+// response without blocking before closing the connection. One thread
+// serves every connection, so a connection costs a map entry, not a thread.
+class Reactor final : public IoEngine {
+public:
+    // Connections that send no complete request within this are closed
+    static constexpr std::chrono::seconds REQUEST_TIMEOUT{30};
+
+    // listen_fd must already be listening; throws std::runtime_error when
+    // epoll or the wake-up eventfd cannot be created
+    Reactor(int listen_fd, RequestHandler onRequest);
+    ~Reactor() override;
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    void run(const volatile sig_atomic_t& running) override;
+    void respond(int client_fd, std::string response) override;
+    const char* name() const override { return "epoll"; }
+
+private:
+    enum class State { READING, WAITING, WRITING };
+
+    struct Connection {
+        std::string ip;
+        std::string buffer;   // Request bytes while reading, response bytes while writing
+        size_t sent = 0;
+        State state = State::READING;
+        std::chrono::steady_clock::time_point opened;
+    };
+
+    void acceptAll();
+    void readable(int fd, Connection& conn);
+    void writable(int fd, Connection& conn);
+    void flushResponses();
+    void expireIdle();
+    void closeConnection(int fd);
+
+    int listenFd;
+    int epollFd = -1;
+    int wakeFd = -1;    // eventfd that respond() pokes
+    RequestHandler onRequest;
+    std::unordered_map<int, Connection> connections;
+    std::chrono::steady_clock::time_point lastSweep;
+
+    std::mutex responseMutex;
+    std::vector<std::pair<int, std::string>> responses;   // Handed over by respond()
+};
+
+} // namespace graph
@@ -2,8 +2,17 @@
 #include <memory>
 #include <vector>
 #include <cassert>
+#include <type_traits>
+#include <utility>
+#include <set>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <thread>
 #include "graph.hpp"
 #include "graph_algorithm.hpp"
+#include "csr_graph.hpp"
+#include "work_stealing_pool.hpp"
 #include "point.hpp"
 
 // Test Point class functionality
@@ -181,6 +190,1101 @@ void testGraphEdgeCases() {
     std::cout << "Graph edge case tests completed!\n\n";
 }
 
+// Test arena-backed adjacency through add/remove/copy cycles
+void testNeighborArena() {
+    std::cout << "Testing Neighbor Arena:\n";
+    std::cout << "========================================\n";
+    
+    graph::NeighborArena arena;
+    graph::Neighbor* first = arena.allocate(1, 5);
+    arena.deallocate(first);
+    graph::Neighbor* reused = arena.allocate(2, 7);
+    assert(reused == first); // Free list recycles the slot
+    assert(reused->dest == 2 && reused->weight == 7 && reused->next == nullptr);
+    
+    graph::Graph g(50);
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 49; i++) {
+            g.addEdge(i, i + 1, round + 1);
+        }
+        for (int i = 0; i < 49; i += 2) {
+            g.removeEdge(i, i + 1);
+        }
+        for (int i = 0; i < 49; i += 2) {
+            g.addEdge(i, i + 1, round + 1);
+        }
+    }
+    assert(g.getNumEdges() == 49);
+    assert(g.getEdgeWeight(10, 11) == 3);
+    
+    graph::Graph copy(g);
+    graph::Graph assigned(2);
+    assigned.addEdge(0, 1);
+    assigned = g;
+    for (int i = 0; i < 49; i++) {
+        assert(copy.hasEdge(i, i + 1) && assigned.hasEdge(i + 1, i));
+        assert(copy.getNeighbors(i) != g.getNeighbors(i)); // Deep copy
+    }
+    g.removeEdge(0, 1);
+    assert(copy.hasEdge(0, 1) && assigned.hasEdge(0, 1));
+    
+    std::cout << "Neighbor arena tests passed!\n\n";
+}
+
+// Test cached degree/edge counters against a full list walk
+void testCachedCounters() {
+    std::cout << "Testing Cached Degree Counters:\n";
+    std::cout << "========================================\n";
+    
+    graph::Graph g = graph::Graph::generateRandomGraph(40, 300, 3);
+    g.addEdge(0, 1, 9); // May update an existing edge - counters must not move twice
+    for (int v = 0; v < 40; v += 3) {
+        for (int u = v + 1; u < 40; u += 5) {
+            if (g.hasEdge(v, u)) {
+                g.removeEdge(u, v);
+            }
+        }
+    }
+    
+    int halfEdges = 0;
+    for (int v = 0; v < g.getNumVertices(); v++) {
+        int walked = 0;
+        for (graph::Neighbor* current = g.getNeighbors(v); current != nullptr; current = current->next) {
+            walked++;
+        }
+        assert(g.getDegree(v) == walked);
+        halfEdges += walked;
+    }
+    assert(g.getNumEdges() * 2 == halfEdges);
+    
+    graph::Graph copy(g);
+    assert(copy.getNumEdges() == g.getNumEdges());
+    assert(copy.getDegree(5) == g.getDegree(5));
+    
+    std::cout << "Cached counter tests passed!\n\n";
+}
+
+// Test random generation: exact edge counts, no duplicates, reproducible
+void testRandomGeneration() {
+    std::cout << "Testing Random Graph Generation:\n";
+    std::cout << "========================================\n";
+    
+    struct Case { int vertices; int edges; };
+    // Sparse, half density boundary, near complete, over-requested
+    std::vector<Case> cases = {{1000, 5000}, {40, 390}, {40, 779}, {12, 1000}, {2, 1}, {1, 5}};
+    for (const Case& c : cases) {
+        auto edges = graph::Graph::generateRandomEdges(c.vertices, c.edges, 99);
+        long long maxEdges = static_cast<long long>(c.vertices) * (c.vertices - 1) / 2;
+        assert(static_cast<long long>(edges.size()) == std::min<long long>(c.edges, maxEdges));
+        std::set<std::pair<int, int>> unique;
+        for (const auto& e : edges) {
+            assert(0 <= e.first && e.first < e.second && e.second < c.vertices);
+            unique.insert(e);
+        }
+        assert(unique.size() == edges.size());
+        assert(edges == graph::Graph::generateRandomEdges(c.vertices, c.edges, 99));
+        
+        graph::Graph g = graph::Graph::generateRandomGraph(c.vertices, c.edges, 99);
+        assert(g.getNumEdges() == static_cast<int>(edges.size()));
+    }
+    assert(graph::Graph::generateRandomEdges(100, 300, 1) != graph::Graph::generateRandomEdges(100, 300, 2));
+    
+    // Parallel sampling is bit-identical whatever the thread count
+    for (const Case& c : std::vector<Case>{{3000, 400000}, {900, 330000}, {50000, 200000}}) {
+        auto reference = graph::Graph::generateRandomEdges(c.vertices, c.edges, 2024, 1);
+        assert(static_cast<int>(reference.size()) == c.edges);
+        for (unsigned int threads : {2u, 3u, 8u, 0u}) {
+            assert(graph::Graph::generateRandomEdges(c.vertices, c.edges, 2024, threads) == reference);
+        }
+        std::set<std::pair<int, int>> unique(reference.begin(), reference.end());
+        assert(unique.size() == reference.size());
+    }
+    
+    std::cout << "Random generation tests passed!\n\n";
+}
+
+// Test iterative Euler circuit on dense and very long graphs
+void testEulerCircuitLarge() {
+    std::cout << "Testing Large Euler Circuits:\n";
+    std::cout << "========================================\n";
+    
+    // K9: every vertex has degree 8, circuit must use each edge exactly once
+    graph::Graph complete(9);
+    for (int i = 0; i < 9; i++) {
+        for (int j = i + 1; j < 9; j++) {
+            complete.addEdge(i, j);
+        }
+    }
+    std::vector<int> circuit = complete.findEulerCircuit();
+    assert(static_cast<int>(circuit.size()) == complete.getNumEdges() + 1);
+    assert(circuit.front() == circuit.back());
+    std::set<std::pair<int, int>> seen;
+    for (size_t i = 0; i + 1 < circuit.size(); i++) {
+        int u = std::min(circuit[i], circuit[i + 1]);
+        int v = std::max(circuit[i], circuit[i + 1]);
+        assert(complete.hasEdge(u, v));
+        assert(seen.insert({u, v}).second);
+    }
+    
+    // A long cycle used to overflow the recursive version
+    const int cycleLength = 200000;
+    graph::Graph cycle(cycleLength);
+    for (int i = 0; i < cycleLength; i++) {
+        cycle.addEdge(i, (i + 1) % cycleLength);
+    }
+    circuit = cycle.findEulerCircuit();
+    assert(static_cast<int>(circuit.size()) == cycleLength + 1);
+    assert(circuit.front() == 0 && circuit.back() == 0);
+    std::cout << "Euler circuit over " << cycleLength << " edges found\n";
+    
+    // The graph itself is left untouched
+    assert(cycle.getNumEdges() == cycleLength);
+    
+    std::cout << "Large Euler circuit tests passed!\n\n";
+}
+
+// Breadth-first labels (smallest vertex of each component), ignoring edge direction
+static std::vector<int> bfsComponentLabels(const graph::CSRGraph& g) {
+    graph::CSRGraph undirected = g.symmetrized();
+    std::vector<int> label(g.getNumVertices(), -1);
+    for (int s = 0; s < g.getNumVertices(); s++) {
+        if (label[s] != -1) continue;
+        std::vector<int> queue = {s};
+        label[s] = s;
+        for (size_t i = 0; i < queue.size(); i++) {
+            for (const auto& edge : undirected.neighbors(queue[i])) {
+                if (label[edge.dest] == -1) {
+                    label[edge.dest] = s;
+                    queue.push_back(edge.dest);
+                }
+            }
+        }
+    }
+    return label;
+}
+
+// Test component labels against BFS, and connectivity on large graphs
+void testConnectedComponents() {
+    std::cout << "Testing Connected Components:\n";
+    std::cout << "========================================\n";
+    
+    graph::Graph g(7);
+    g.addEdge(0, 1);
+    g.addEdge(1, 2);
+    g.addEdge(4, 5);
+    assert(g.connectedComponents() == std::vector<int>({0, 0, 0, 3, 4, 4, 6}));
+    assert(!g.isConnected());
+    // Isolated vertices do not count against connectivity
+    g.addEdge(5, 2);
+    assert(g.connectedComponents(4) == std::vector<int>({0, 0, 0, 3, 0, 0, 6}));
+    assert(g.isConnected(4));
+    
+    // Labels match BFS on both stores, for any thread count
+    std::mt19937 rng(61);
+    for (int trial = 0; trial < 200; trial++) {
+        int n = 1 + static_cast<int>(rng() % 300);
+        int edges = static_cast<int>(rng() % (2 * n + 1));
+        bool directed = trial % 2 == 1;
+        graph::Graph list = graph::Graph::generateRandomGraph(n, edges, rng(), 1, directed);
+        graph::CSRGraph csr(list);
+        std::vector<int> expected = bfsComponentLabels(csr);
+        for (unsigned int threads : {1u, 3u}) {
+            assert(list.connectedComponents(threads) == expected);
+            assert(csr.connectedComponents(threads) == expected);
+        }
+    }
+    
+    // Many vertex chunks: giant-component skipping and the parallel phases
+    for (bool directed : {false, true}) {
+        graph::CSRGraph big = graph::CSRGraph::generateRandomGraph(200000, 220000, 8, 1, directed);
+        std::vector<int> expected = bfsComponentLabels(big);
+        for (unsigned int threads : {1u, 4u, 0u}) {
+            assert(big.connectedComponents(threads) == expected);
+        }
+    }
+    
+    // Two long disjoint cycles: even degrees, but no Euler circuit
+    graph::Graph cycles(400000);
+    for (int v = 0; v < 200000; v++) {
+        cycles.addEdge(v, (v + 1) % 200000);
+        cycles.addEdge(200000 + v, 200000 + (v + 1) % 200000);
+    }
+    assert(!cycles.isConnected(0) && !cycles.hasEulerCircuit(0));
+    cycles.removeEdge(0, 1);
+    cycles.removeEdge(200000, 200001);
+    cycles.addEdge(0, 200000);
+    cycles.addEdge(1, 200001);
+    assert(cycles.hasEulerCircuit(0));
+    assert(cycles.findEulerCircuit(0).size() == 400001);
+    std::cout << "400k-vertex cycles joined into one Euler circuit\n";
+    
+    std::cout << "Connected component tests passed!\n\n";
+}
+
+// Test Prim, Kruskal and Boruvka agree on weights and forests, also on
+// disconnected graphs and with several threads
+void testSpanningForest() {
+    std::cout << "Testing Spanning Forest Engines:\n";
+    std::cout << "========================================\n";
+    
+    auto prim = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MST_WEIGHT);
+    auto kruskal = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MST_KRUSKAL);
+    auto boruvka = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MST_BORUVKA);
+    auto boruvkaParallel = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MST_BORUVKA, 3);
+    
+    // Two trees: Prim only sees the one holding vertex 0
+    graph::Graph forest(7);
+    forest.addEdge(0, 1, 4);
+    forest.addEdge(1, 2, 1);
+    forest.addEdge(0, 2, 2);
+    forest.addEdge(3, 4, 7);
+    forest.addEdge(4, 5, -3);
+    forest.addEdge(3, 5, 5);
+    assert(prim->execute(forest) == "Graph is not connected - MST weight: 3");
+    assert(kruskal->execute(forest) == "Graph is not connected - spanning forest weight: 5 (2 trees)");
+    assert(boruvka->execute(forest) == kruskal->execute(forest));
+    assert(boruvkaParallel->execute(forest) == kruskal->execute(forest));
+    
+    // Isolated vertices are not trees of their own
+    graph::Graph isolated(5);
+    isolated.addEdge(1, 2, 6);
+    assert(kruskal->execute(isolated) == "MST Weight: 6");
+    assert(boruvka->execute(isolated) == "MST Weight: 6");
+    
+    // Random weighted graphs, including negative weights and ties
+    std::mt19937 rng(41);
+    for (int trial = 0; trial < 200; trial++) {
+        int n = 1 + static_cast<int>(rng() % 60);
+        graph::Graph g(n);
+        int attempts = static_cast<int>(rng() % (n * 3 + 1));
+        for (int k = 0; k < attempts; k++) {
+            int u = static_cast<int>(rng() % n);
+            int v = static_cast<int>(rng() % n);
+            if (u != v) {
+                g.addEdge(u, v, static_cast<int>(rng() % 2000) - 1000);
+            }
+        }
+        graph::CSRGraph csr(g);
+        std::string expected = kruskal->execute(csr);
+        assert(boruvka->execute(csr) == expected);
+        assert(boruvkaParallel->execute(csr) == expected);
+        std::string primResult = prim->execute(csr);
+        if (primResult.compare(0, 11, "MST Weight:") == 0) {
+            assert(primResult == expected);
+        }
+    }
+    
+    // Dense graph with many key decreases, and weights whose total
+    // overflows int (Prim's heap holds at most one entry per vertex)
+    for (int vertices : {300, 20000}) {
+        int edgeCount = vertices == 300 ? 40000 : 100000;
+        graph::Graph heavy(vertices);
+        for (const auto& edge : graph::Graph::generateRandomEdges(vertices, edgeCount, 8)) {
+            heavy.addEdge(edge.first, edge.second, 1 + static_cast<int>(rng() % 1000000));
+        }
+        graph::CSRGraph csr(heavy);
+        assert(prim->execute(csr) == kruskal->execute(csr));
+    }
+    
+    // Large sparse graph: all three engines agree
+    graph::CSRGraph large = graph::CSRGraph::generateRandomGraph(200000, 1000000, 12);
+    std::string result = kruskal->execute(large);
+    assert(boruvka->execute(large) == result);
+    assert(boruvkaParallel->execute(large) == result);
+    assert(prim->execute(large) == result);
+    std::cout << "200k vertices, 1M edges: " << result << "\n";
+    
+    std::cout << "Spanning forest tests passed!\n\n";
+}
+
+// Test SCC output against BFS labelling on random graphs and a path too deep to recurse
+void testSCC() {
+    std::cout << "Testing Strongly Connected Components:\n";
+    std::cout << "========================================\n";
+    
+    auto scc = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::SCC);
+    
+    graph::Graph small(6);
+    small.addEdge(0, 1);
+    small.addEdge(1, 2);
+    small.addEdge(3, 4);
+    assert(scc->execute(small) == "Found 3 Strongly Connected Components:\n"
+                                  "SCC 1: {0, 1, 2}\n"
+                                  "SCC 2: {3, 4}\n"
+                                  "SCC 3: {5}\n");
+    
+    // Components match a BFS labelling on random graphs
+    std::mt19937 rng(53);
+    for (int trial = 0; trial < 100; trial++) {
+        int n = 1 + static_cast<int>(rng() % 80);
+        graph::CSRGraph g = graph::CSRGraph::generateRandomGraph(n, static_cast<int>(rng() % (n + 1)), rng());
+        std::vector<int> label(n, -1);
+        int labels = 0;
+        for (int s = 0; s < n; s++) {
+            if (label[s] != -1) continue;
+            std::vector<int> queue = {s};
+            label[s] = labels;
+            for (size_t i = 0; i < queue.size(); i++) {
+                for (const auto& edge : g.neighbors(queue[i])) {
+                    if (label[edge.dest] == -1) {
+                        label[edge.dest] = labels;
+                        queue.push_back(edge.dest);
+                    }
+                }
+            }
+            labels++;
+        }
+        
+        std::string result = scc->execute(g);
+        assert(result.compare(0, 6 + std::to_string(labels).size(), "Found " + std::to_string(labels)) == 0);
+        std::set<std::set<int>> expected, found;
+        std::vector<std::set<int>> byLabel(labels);
+        for (int v = 0; v < n; v++) {
+            byLabel[label[v]].insert(v);
+        }
+        expected.insert(byLabel.begin(), byLabel.end());
+        size_t pos = 0;
+        while ((pos = result.find('{', pos)) != std::string::npos) {
+            std::set<int> component;
+            size_t end = result.find('}', pos);
+            std::string body = result.substr(pos + 1, end - pos - 1);
+            for (size_t start = 0; start < body.size();) {
+                size_t comma = body.find(", ", start);
+                component.insert(std::stoi(body.substr(start, comma - start)));
+                start = comma == std::string::npos ? body.size() : comma + 2;
+            }
+            found.insert(component);
+            pos = end;
+        }
+        assert(found == expected);
+    }
+    
+    // A 1M-vertex path: recursive DFS would overflow the stack
+    std::vector<std::pair<int, int>> path;
+    for (int v = 0; v + 1 < 1000000; v++) {
+        path.push_back({v, v + 1});
+    }
+    std::string result = scc->execute(graph::CSRGraph::fromEdges(1000000, path));
+    assert(result.compare(0, 45, "Found 1 Strongly Connected Components:\nSCC 1:") == 0);
+    std::cout << "1M-vertex path is a single component\n";
+    
+    std::cout << "SCC tests passed!\n\n";
+}
+
+// Test max flow values and sparse graphs far too large for a dense matrix
+void testMaxFlow() {
+    std::cout << "Testing Max Flow:\n";
+    std::cout << "========================================\n";
+    
+    auto maxFlow = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MAX_FLOW);
+    
+    // Undirected: min cut is around the source (2 + 4)
+    graph::Graph network(4);
+    network.addEdge(0, 1, 2);
+    network.addEdge(1, 3, 5);
+    network.addEdge(0, 2, 4);
+    network.addEdge(2, 3, 3);
+    network.addEdge(1, 2, 1);
+    assert(maxFlow->execute(network) == "Max Flow from node 0 to node 3: 6");
+    
+    // No path to the sink
+    graph::Graph cut(3);
+    cut.addEdge(0, 1, 7);
+    assert(maxFlow->execute(cut) == "Max Flow from node 0 to node 2: 0");
+    
+    // 50k vertices: the old residual matrix alone would need ~10 GB
+    graph::CSRGraph sparse = graph::CSRGraph::generateRandomGraph(50000, 150000, 5);
+    std::string result = maxFlow->execute(sparse);
+    const std::string prefix = "Max Flow from node 0 to node 49999: ";
+    assert(result.compare(0, prefix.size(), prefix) == 0);
+    // Unit capacities: flow is bounded by the degree of either terminal
+    int flow = std::stoi(result.substr(prefix.size()));
+    assert(flow >= 0 && flow <= std::min(sparse.getDegree(0), sparse.getDegree(49999)));
+    std::cout << "Sparse 50k-vertex graph: " << result << "\n";
+    
+    // Push-relabel must agree with Dinic on random weighted graphs
+    auto pushRelabel = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MAX_FLOW_PR);
+    assert(pushRelabel->execute(network) == "Max Flow from node 0 to node 3: 6");
+    assert(pushRelabel->execute(cut) == "Max Flow from node 0 to node 2: 0");
+    assert(pushRelabel->execute(sparse) == result);
+    std::mt19937 rng(17);
+    for (int trial = 0; trial < 200; trial++) {
+        int n = 2 + static_cast<int>(rng() % 40);
+        graph::Graph g(n);
+        int attempts = static_cast<int>(rng() % (n * n));
+        for (int k = 0; k < attempts; k++) {
+            int u = static_cast<int>(rng() % n);
+            int v = static_cast<int>(rng() % n);
+            if (u != v) {
+                g.addEdge(u, v, 1 + static_cast<int>(rng() % 50));
+            }
+        }
+        graph::CSRGraph csr(g);
+        assert(pushRelabel->execute(csr) == maxFlow->execute(csr));
+    }
+    graph::CSRGraph dense = graph::CSRGraph::generateRandomGraph(400, 60000, 8);
+    assert(pushRelabel->execute(dense) == maxFlow->execute(dense));
+    
+    std::cout << "Max flow tests passed!\n\n";
+}
+
+// Test max clique against brute force, on a planted clique and large
+// sparse graphs, and for any thread count
+void testMaxClique() {
+    std::cout << "Testing Max Clique:\n";
+    std::cout << "========================================\n";
+    
+    auto maxClique = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MAX_CLIQUE);
+    
+    // Two triangles tie: the lexicographically smaller one is reported
+    graph::Graph twoTriangles(7);
+    twoTriangles.addEdge(4, 5);
+    twoTriangles.addEdge(5, 6);
+    twoTriangles.addEdge(4, 6);
+    twoTriangles.addEdge(1, 2);
+    twoTriangles.addEdge(2, 3);
+    twoTriangles.addEdge(1, 3);
+    twoTriangles.addEdge(0, 4);
+    assert(maxClique->execute(twoTriangles) == "Max Clique Size: 3\nMax Clique Vertices: {1, 2, 3}");
+    
+    graph::Graph isolated(3);
+    assert(maxClique->execute(isolated) == "Max Clique Size: 1\nMax Clique Vertices: {0}");
+    
+    // Brute force over all vertex subsets of small random graphs
+    std::mt19937 rng(29);
+    for (int trial = 0; trial < 200; trial++) {
+        int n = 1 + static_cast<int>(rng() % 14);
+        graph::Graph g(n);
+        int density = static_cast<int>(rng() % 100);
+        for (int u = 0; u < n; u++) {
+            for (int v = u + 1; v < n; v++) {
+                if (static_cast<int>(rng() % 100) < density) {
+                    g.addEdge(u, v);
+                }
+            }
+        }
+        int bestMask = 0;
+        int bestCount = 0;
+        for (int mask = 1; mask < (1 << n); mask++) {
+            bool isClique = true;
+            for (int u = 0; u < n && isClique; u++) {
+                for (int v = u + 1; v < n && isClique; v++) {
+                    if ((mask >> u & 1) && (mask >> v & 1) && !g.hasEdge(u, v)) {
+                        isClique = false;
+                    }
+                }
+            }
+            int count = __builtin_popcount(mask);
+            // Equal sizes: the set holding the lowest differing vertex is smaller
+            if (isClique && (count > bestCount || (count == bestCount && (mask >> __builtin_ctz(mask ^ bestMask) & 1)))) {
+                bestMask = mask;
+                bestCount = count;
+            }
+        }
+        std::string expected = "Max Clique Size: " + std::to_string(bestCount) + "\nMax Clique Vertices: {";
+        bool first = true;
+        for (int v = 0; v < n; v++) {
+            if (bestMask >> v & 1) {
+                expected += (first ? "" : ", ") + std::to_string(v);
+                first = false;
+            }
+        }
+        expected += "}";
+        assert(maxClique->execute(g) == expected);
+    }
+    
+    // Dense 200-vertex graph with a planted 24-clique, far above the ~11
+    // expected by chance; the old list-based search could not finish this
+    graph::Graph dense = graph::Graph::generateRandomGraph(200, 9950, 3);
+    std::vector<int> planted;
+    for (int v = 7; v < 200 && planted.size() < 24; v += 8) {
+        planted.push_back(v);
+    }
+    for (size_t i = 0; i < planted.size(); i++) {
+        for (size_t j = i + 1; j < planted.size(); j++) {
+            dense.addEdge(planted[i], planted[j]);
+        }
+    }
+    std::string expected = "Max Clique Size: 24\nMax Clique Vertices: {";
+    for (size_t i = 0; i < planted.size(); i++) {
+        expected += (i > 0 ? ", " : "") + std::to_string(planted[i]);
+    }
+    expected += "}";
+    assert(maxClique->execute(dense) == expected);
+    std::cout << "Planted clique found in dense 200-vertex graph\n";
+    
+    // Sparse large graph: degeneracy keeps every subproblem small
+    graph::CSRGraph sparse = graph::CSRGraph::generateRandomGraph(100000, 1000000, 11);
+    std::string result = maxClique->execute(sparse);
+    std::cout << "Sparse 100k-vertex graph: " << result.substr(0, result.find('\n')) << "\n";
+    
+    // Parallel search reports the same clique for any thread count, also
+    // when several maximum cliques tie (five disjoint 4-cliques plus noise)
+    graph::Graph ties(40);
+    for (int c = 4; c >= 0; c--) {
+        for (int i = 0; i < 4; i++) {
+            for (int j = i + 1; j < 4; j++) {
+                ties.addEdge(20 + c * 4 + i, 20 + c * 4 + j);
+            }
+        }
+    }
+    for (int v = 0; v < 19; v++) {
+        ties.addEdge(v, v + 1);
+    }
+    std::vector<graph::CSRGraph> parallelCases = {
+        graph::CSRGraph(ties),
+        graph::CSRGraph(dense),
+        graph::CSRGraph::generateRandomGraph(150, 8000, 21),
+        graph::CSRGraph::generateRandomGraph(20000, 200000, 4)
+    };
+    for (const auto& g : parallelCases) {
+        std::string sequential = maxClique->execute(g);
+        for (unsigned int threads : {2u, 3u, 5u, 0u}) {
+            auto parallel = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MAX_CLIQUE, threads);
+            assert(parallel->execute(g) == sequential);
+        }
+    }
+    assert(parallelCases[0].getNumEdges() == 49);
+    assert(maxClique->execute(parallelCases[0]) == "Max Clique Size: 4\nMax Clique Vertices: {20, 21, 22, 23}");
+    
+    std::cout << "Max clique tests passed!\n\n";
+}
+
+// Test the work-stealing pool: every task once, errors, and concurrent or nested runs
+void testWorkStealingPool() {
+    std::cout << "Testing Work-Stealing Pool:\n";
+    std::cout << "========================================\n";
+    
+    // Every task runs exactly once, however uneven the tasks are
+    for (unsigned int threads : {1u, 3u, 0u}) {
+        graph::WorkStealingPool pool(threads);
+        assert(pool.size() >= 1);
+        std::vector<std::atomic<int>> runs(500);
+        std::atomic<long> work(0);
+        pool.run(runs.size(), [&](size_t task, unsigned int worker) {
+            assert(worker < pool.size());
+            runs[task]++;
+            long sum = 0;
+            for (size_t i = 0; i < (task % 50 == 0 ? 200000 : 10); i++) {
+                sum += static_cast<long>(i % 7);
+            }
+            work += sum > 0 ? 1 : 0;
+        });
+        for (const auto& count : runs) {
+            assert(count == 1);
+        }
+        assert(work == 500);
+        
+        // Reusable after a run, including an empty one
+        pool.run(0, [](size_t, unsigned int) { assert(false); });
+    }
+    
+    // The first exception reaches the caller and the pool stays usable
+    graph::WorkStealingPool pool(4);
+    bool caught = false;
+    try {
+        pool.run(100, [](size_t task, unsigned int) {
+            if (task == 42) {
+                throw std::runtime_error("task failed");
+            }
+        });
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()) == "task failed";
+    }
+    assert(caught);
+    std::atomic<int> after(0);
+    pool.run(10, [&](size_t, unsigned int) { after++; });
+    assert(after == 10);
+    
+    // Pools share the helper threads: concurrent and nested runs all finish
+    std::atomic<int> nested(0);
+    std::vector<std::thread> callers;
+    for (int c = 0; c < 4; c++) {
+        callers.emplace_back([&] {
+            graph::WorkStealingPool outer(3);
+            outer.run(20, [&](size_t, unsigned int) {
+                graph::WorkStealingPool inner(2);
+                inner.run(5, [&](size_t, unsigned int) { nested++; });
+            });
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    assert(nested == 4 * 20 * 5);
+    
+    std::cout << "Work-stealing pool tests passed!\n\n";
+}
+
+// Test typed results: text matches execute(), binary round-trips exactly
+void testAlgorithmResults() {
+    std::cout << "Testing Algorithm Results:\n";
+    std::cout << "========================================\n";
+    
+    graph::AlgorithmResult flow = graph::FlowResult{0, 3, 6};
+    assert(graph::toText(flow) == "Max Flow from node 0 to node 3: 6");
+    assert(graph::toBinary(flow) == std::string("\x03\x00\x00\x00\x00\x03\x00\x00\x00\x06\x00\x00\x00\x00\x00\x00\x00", 17));
+    assert(graph::toText(graph::SpanningTreeResult{-5, false, 3}) ==
+           "Graph is not connected - spanning forest weight: -5 (3 trees)");
+    assert(graph::toText(graph::SCCResult{{0, 2, 3}, {4, 1, 0}}) ==
+           "Found 2 Strongly Connected Components:\nSCC 1: {4, 1}\nSCC 2: {0}\n");
+    
+    // Every engine on a mix of graphs: text is unchanged by a binary round trip
+    std::vector<graph::CSRGraph> graphs = {
+        graph::CSRGraph::generateRandomGraph(1, 0, 1),
+        graph::CSRGraph::generateRandomGraph(30, 60, 2),
+        graph::CSRGraph::generateRandomGraph(30, 20, 3),
+        graph::CSRGraph::generateRandomGraph(30, 90, 4, 1, true)
+    };
+    for (auto type : {graph::AlgorithmFactory::AlgorithmType::MST_WEIGHT,
+                      graph::AlgorithmFactory::AlgorithmType::MST_KRUSKAL,
+                      graph::AlgorithmFactory::AlgorithmType::MST_BORUVKA,
+                      graph::AlgorithmFactory::AlgorithmType::SCC,
+                      graph::AlgorithmFactory::AlgorithmType::MAX_FLOW,
+                      graph::AlgorithmFactory::AlgorithmType::MAX_FLOW_PR,
+                      graph::AlgorithmFactory::AlgorithmType::MAX_CLIQUE}) {
+        auto algorithm = graph::AlgorithmFactory::createAlgorithm(type);
+        for (const auto& g : graphs) {
+            graph::AlgorithmResult result = algorithm->compute(g);
+            std::string bytes = graph::toBinary(result);
+            graph::AlgorithmResult decoded = graph::fromBinary(bytes);
+            assert(decoded.index() == result.index());
+            assert(graph::toBinary(decoded) == bytes);
+            assert(graph::toText(decoded) == algorithm->execute(g));
+            
+            // Every strict prefix is rejected, and so is a trailing byte
+            for (size_t cut = 0; cut < bytes.size(); cut++) {
+                bool threw = false;
+                try {
+                    graph::fromBinary(bytes.substr(0, cut));
+                } catch (const std::invalid_argument&) {
+                    threw = true;
+                }
+                assert(threw);
+            }
+            bool threw = false;
+            try {
+                graph::fromBinary(bytes + '\0');
+            } catch (const std::invalid_argument&) {
+                threw = true;
+            }
+            assert(threw);
+        }
+    }
+    
+    bool threw = false;
+    try {
+        graph::fromBinary(std::string(1, '\x09'));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "Algorithm result tests passed!\n\n";
+}
+
+// Test the algorithm registry, name lookup and allocation-free dispatch
+void testAlgorithmRegistry() {
+    std::cout << "Testing Algorithm Registry:\n";
+    std::cout << "========================================\n";
+    
+    using Factory = graph::AlgorithmFactory;
+    const auto& registry = Factory::registry();
+    assert(registry.size() == 7);
+    assert(Factory::availableNames() == "MST_WEIGHT, MST_KRUSKAL, MST_BORUVKA, SCC, MAX_FLOW, MAX_FLOW_PR, MAX_CLIQUE");
+    
+    graph::CSRGraph g = graph::CSRGraph::generateRandomGraph(40, 120, 12);
+    for (size_t i = 0; i < registry.size(); i++) {
+        const auto& entry = registry[i];
+        assert(static_cast<size_t>(entry.type) == i);
+        assert(Factory::find(entry.key) == &entry);
+        assert(&Factory::info(entry.type) == &entry);
+        assert(Factory::getAlgorithmName(entry.type) == entry.key);
+        
+        auto algorithm = Factory::createAlgorithm(entry.type, 2);
+        assert(algorithm->getName() == entry.title);
+        assert(graph::toBinary(Factory::run(entry.type, g, 2)) == graph::toBinary(algorithm->compute(g)));
+    }
+    assert(Factory::find("BOGUS") == nullptr);
+    assert(Factory::find("mst_weight") == nullptr);
+    
+    auto unknown = static_cast<Factory::AlgorithmType>(99);
+    assert(Factory::createAlgorithm(unknown) == nullptr);
+    assert(Factory::getAlgorithmName(unknown) == "UNKNOWN");
+    bool threw = false;
+    try {
+        Factory::run(unknown, g);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Pipeline stages honour a requested engine only for its own problem
+    assert(Factory::select(Factory::Problem::SPANNING_TREE, "MST_BORUVKA") == Factory::AlgorithmType::MST_BORUVKA);
+    assert(Factory::select(Factory::Problem::SPANNING_TREE, "MAX_FLOW_PR") == Factory::AlgorithmType::MST_WEIGHT);
+    assert(Factory::select(Factory::Problem::MAX_FLOW, "MAX_FLOW_PR") == Factory::AlgorithmType::MAX_FLOW_PR);
+    assert(Factory::select(Factory::Problem::MAX_FLOW, "EULER") == Factory::AlgorithmType::MAX_FLOW);
+    assert(Factory::select(Factory::Problem::SCC, "") == Factory::AlgorithmType::SCC);
+    assert(Factory::select(Factory::Problem::MAX_CLIQUE, "MAX_CLIQUE") == Factory::AlgorithmType::MAX_CLIQUE);
+    
+    std::cout << "Algorithm registry tests passed!\n\n";
+}
+
+// Test workspace leases, stamped arrays and scratch reuse across requests
+void testWorkspace() {
+    std::cout << "Testing Workspace:\n";
+    std::cout << "========================================\n";
+    
+    graph::StampedArray<int> level;
+    level.reset(4, -1);
+    level.set(2, 7);
+    level[3] += 5;
+    assert(level.get(0) == -1 && level.get(2) == 7 && level.get(3) == 4);
+    assert(level.touched(2) && !level.touched(1));
+    level.reset(6, 0);
+    for (int i = 0; i < 6; i++) {
+        assert(level.get(i) == 0 && !level.touched(i));
+    }
+    
+    graph::StampedSet seen;
+    seen.reset(3);
+    seen.insert(1);
+    assert(seen.contains(1) && !seen.contains(0));
+    seen.reset(3);
+    assert(!seen.contains(1));
+    
+    // A returned object is handed out again, capacity intact
+    graph::Workspace workspace;
+    const std::vector<int>* first;
+    {
+        auto a = workspace.borrow<std::vector<int>>();
+        auto b = workspace.borrow<std::vector<int>>();
+        assert(&*a != &*b);
+        a->assign(1000, 1);
+        first = &*a;
+    }
+    {
+        auto again = workspace.borrow<std::vector<int>>();
+        auto other = workspace.borrow<std::vector<int>>();
+        assert(&*again == first || &*other == first);
+        assert(first->capacity() >= 1000);
+    }
+    
+    // One workspace across growing and shrinking graphs gives the same
+    // answers as a fresh one per call
+    const int sizes[][2] = {{60, 200}, {8, 10}, {120, 900}, {1, 0}, {30, 40}, {200, 300}, {12, 60}};
+    for (int round = 0; round < 14; round++) {
+        const int* size = sizes[round % 7];
+        bool directed = round >= 7;
+        graph::CSRGraph g = graph::CSRGraph::generateRandomGraph(size[0], size[1], 100 + round, 1, directed);
+        for (const auto& entry : graph::AlgorithmFactory::registry()) {
+            std::string reused = graph::toBinary(graph::AlgorithmFactory::run(entry.type, g, workspace, 2));
+            assert(reused == graph::toBinary(graph::AlgorithmFactory::run(entry.type, g, 2)));
+        }
+    }
+    
+    std::cout << "Workspace tests passed!\n\n";
+}
+
+// Test time budgets: tokens, pollers and partial (anytime) results
+void testCancellation() {
+    std::cout << "Testing Cancellation:\n";
+    std::cout << "========================================\n";
+    
+    graph::CancellationToken never;
+    assert(!never.expired());
+    never.cancel();
+    assert(never.expired());
+    assert(graph::CancellationToken(std::chrono::milliseconds(0)).expired());
+    assert(!graph::CancellationToken(std::chrono::hours(1)).expired());
+    
+    graph::CancellationPoller idle;
+    for (unsigned int i = 0; i < 2 * graph::CancellationPoller::STRIDE; i++) {
+        assert(!idle.poll());
+    }
+    graph::CancellationToken token;
+    graph::CancellationPoller poller(token);
+    assert(!poller.poll() && !poller.stopped());
+    token.cancel();
+    unsigned int polls = 1;
+    while (!poller.poll()) {
+        polls++;
+    }
+    assert(polls <= graph::CancellationPoller::STRIDE && poller.stopped() && poller.poll());
+    
+    // Partial results carry the flag through text and binary
+    graph::AlgorithmResult flow = graph::FlowResult{0, 3, 6, true};
+    assert(graph::isPartial(flow));
+    assert(graph::toText(flow) == "Max Flow from node 0 to node 3: 6 (partial: time budget exceeded)");
+    std::string bytes = graph::toBinary(flow);
+    assert(static_cast<unsigned char>(bytes[0]) == 0x83);
+    assert(graph::isPartial(graph::fromBinary(bytes)));
+    graph::AlgorithmResult clique = graph::CliqueResult{{2, 5}, true};
+    assert(graph::toText(graph::fromBinary(graph::toBinary(clique))) ==
+           "Max Clique Size: 2 (partial: time budget exceeded)\nMax Clique Vertices: {2, 5}");
+    bytes = graph::toBinary(graph::SpanningTreeResult{4, true, 1});
+    bytes[0] = static_cast<char>(bytes[0] | 0x80);
+    bool threw = false;
+    try {
+        graph::fromBinary(bytes);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // A spent budget: near-linear engines still finish, the others stop
+    // at once with a feasible partial answer
+    graph::CSRGraph g = graph::CSRGraph::generateRandomGraph(60, 400, 21);
+    graph::Workspace workspace;
+    graph::CancellationToken spent;
+    spent.cancel();
+    for (const auto& entry : graph::AlgorithmFactory::registry()) {
+        graph::AlgorithmResult full = graph::AlgorithmFactory::run(entry.type, g, workspace, 2);
+        graph::AlgorithmResult cut = graph::AlgorithmFactory::run(entry.type, g, workspace, spent, 2);
+        assert(!graph::isPartial(full));
+        if (const auto* flowCut = std::get_if<graph::FlowResult>(&cut)) {
+            assert(flowCut->partial && flowCut->value <= std::get<graph::FlowResult>(full).value);
+        } else if (const auto* cliqueCut = std::get_if<graph::CliqueResult>(&cut)) {
+            assert(cliqueCut->partial && cliqueCut->vertices.size() <= std::get<graph::CliqueResult>(full).vertices.size());
+        } else {
+            assert(graph::toBinary(cut) == graph::toBinary(full));
+        }
+    }
+    
+    // A deadline in the middle of a long clique search: the search stops
+    // soon after it and what it found is still a clique
+    graph::CSRGraph dense = graph::CSRGraph::generateRandomGraph(300, 31000, 5);
+    auto start = std::chrono::steady_clock::now();
+    graph::CancellationToken budget(std::chrono::milliseconds(30));
+    graph::AlgorithmResult best = graph::AlgorithmFactory::run(graph::AlgorithmFactory::AlgorithmType::MAX_CLIQUE, dense,
+                                                               workspace, budget, 2);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto& found = std::get<graph::CliqueResult>(best);
+    assert(found.partial);
+    assert(elapsed < std::chrono::seconds(2));
+    for (size_t i = 0; i < found.vertices.size(); i++) {
+        for (size_t j = i + 1; j < found.vertices.size(); j++) {
+            bool adjacent = false;
+            for (const auto& edge : dense.neighbors(found.vertices[i])) {
+                adjacent = adjacent || edge.dest == found.vertices[j];
+            }
+            assert(adjacent);
+        }
+    }
+    std::cout << "Clique of size " << found.vertices.size() << " found before the 30 ms deadline\n";
+    
+    std::cout << "Cancellation tests passed!\n\n";
+}
+
+// Test that moves hand over adjacency storage instead of copying it
+void testGraphMoveSemantics() {
+    std::cout << "Testing Graph Move Semantics:\n";
+    std::cout << "========================================\n";
+    
+    static_assert(std::is_nothrow_move_constructible<graph::Graph>::value, "Graph move must be noexcept");
+    static_assert(std::is_nothrow_move_assignable<graph::Graph>::value, "Graph move assignment must be noexcept");
+    
+    graph::Graph source = graph::Graph::generateRandomGraph(20, 60, 11);
+    std::vector<graph::Neighbor*> heads;
+    for (int v = 0; v < source.getNumVertices(); v++) {
+        heads.push_back(source.getNeighbors(v));
+    }
+    
+    // Move construction keeps the very same nodes
+    graph::Graph moved(std::move(source));
+    assert(source.getNumVertices() == 0);
+    assert(moved.getNumEdges() == 60);
+    for (int v = 0; v < moved.getNumVertices(); v++) {
+        assert(moved.getNeighbors(v) == heads[v]);
+    }
+    
+    // Move assignment too, releasing the target's old storage
+    graph::Graph target(3);
+    target.addEdge(0, 1);
+    target = std::move(moved);
+    assert(moved.getNumVertices() == 0);
+    for (int v = 0; v < target.getNumVertices(); v++) {
+        assert(target.getNeighbors(v) == heads[v]);
+    }
+    
+    // Request path: the factory builds in place and matches the value version
+    std::unique_ptr<graph::Graph> owned = graph::Graph::createRandomGraph(20, 60, 11);
+    graph::CSRGraph expected(target);
+    graph::CSRGraph actual(*owned);
+    assert(expected.getOffsets() == actual.getOffsets());
+    assert(expected.getDests() == actual.getDests());
+    
+    std::cout << "Graph move semantics tests passed!\n\n";
+}
+
+// Test CSR snapshot against the linked-list graph
+void testCSRGraph() {
+    std::cout << "Testing CSR Graph:\n";
+    std::cout << "========================================\n";
+    
+    graph::Graph listGraph = graph::Graph::generateRandomGraph(30, 120, 7);
+    graph::CSRGraph csr(listGraph);
+    assert(csr.getNumVertices() == listGraph.getNumVertices());
+    assert(csr.getNumEdges() == listGraph.getNumEdges());
+    
+    // Neighbor ranges must match the linked lists element by element
+    for (int v = 0; v < listGraph.getNumVertices(); v++) {
+        assert(csr.getDegree(v) == listGraph.getDegree(v));
+        graph::Neighbor* current = listGraph.getNeighbors(v);
+        for (const auto& edge : csr.neighbors(v)) {
+            assert(current != nullptr);
+            assert(edge.dest == current->dest);
+            assert(edge.weight == current->weight);
+            current = current->next;
+        }
+        assert(current == nullptr);
+    }
+    
+    // Building straight from the generator gives the same arrays
+    graph::CSRGraph direct = graph::CSRGraph::generateRandomGraph(30, 120, 7);
+    assert(direct.getOffsets() == csr.getOffsets());
+    assert(direct.getDests() == csr.getDests());
+    assert(direct.getWeights() == csr.getWeights());
+    
+    // Transpose of an undirected graph keeps every edge
+    graph::CSRGraph transpose = csr.transposed();
+    for (int v = 0; v < csr.getNumVertices(); v++) {
+        for (const auto& edge : csr.neighbors(v)) {
+            assert(transpose.hasEdge(edge.dest, v));
+            assert(transpose.getEdgeWeight(edge.dest, v) == edge.weight);
+        }
+    }
+    
+    try {
+        csr.neighbors(30);
+        assert(false);
+    } catch (const std::out_of_range& e) {
+        std::cout << "Out of range vertex properly rejected: " << e.what() << "\n";
+    }
+    
+    std::cout << "CSR graph tests passed!\n\n";
+}
+
+// Test directed mode: one-way edges, in-degrees, Euler circuits and
+// algorithms that depend on direction
+void testDirectedGraph() {
+    std::cout << "Testing Directed Graphs:\n";
+    std::cout << "========================================\n";
+    
+    // Edges are stored once, so u -> v and v -> u are independent
+    graph::Graph g(4, true);
+    assert(g.isDirected());
+    g.addEdge(0, 1, 5);
+    assert(g.hasEdge(0, 1) && !g.hasEdge(1, 0));
+    g.addEdge(1, 0, 2);
+    assert(g.getNumEdges() == 2);
+    assert(g.getEdgeWeight(0, 1) == 5 && g.getEdgeWeight(1, 0) == 2);
+    g.addEdge(0, 1, 7);
+    assert(g.getNumEdges() == 2 && g.getEdgeWeight(0, 1) == 7 && g.getEdgeWeight(1, 0) == 2);
+    g.addEdge(2, 1);
+    assert(g.getDegree(1) == 1 && g.getInDegree(1) == 2);
+    assert(g.getDegree(2) == 1 && g.getInDegree(2) == 0);
+    g.removeEdge(0, 1);
+    assert(!g.hasEdge(0, 1) && g.hasEdge(1, 0));
+    assert(g.getNumEdges() == 2 && g.getInDegree(1) == 1 && g.getDegree(0) == 0);
+    
+    // Connectivity ignores direction; 3 is isolated
+    assert(g.isConnected());
+    graph::Graph copy(g);
+    assert(copy.isDirected() && copy.getInDegree(0) == 1 && copy.getNumEdges() == 2);
+    graph::Graph moved(std::move(copy));
+    assert(moved.isDirected() && moved.hasEdge(2, 1) && !moved.hasEdge(1, 2));
+    
+    // Euler circuits follow edge direction and need balanced vertices
+    graph::Graph cycle(3, true);
+    cycle.addEdge(0, 1);
+    cycle.addEdge(1, 2);
+    cycle.addEdge(2, 0);
+    assert(cycle.hasEulerCircuit());
+    assert(cycle.findEulerCircuit() == std::vector<int>({0, 1, 2, 0}));
+    cycle.addEdge(0, 2);
+    assert(!cycle.hasEulerCircuit() && cycle.findEulerCircuit().empty());
+    cycle.addEdge(2, 1);
+    cycle.addEdge(1, 0);
+    std::vector<int> circuit = cycle.findEulerCircuit();
+    assert(circuit.size() == 7 && circuit.front() == circuit.back());
+    std::set<std::pair<int, int>> walked;
+    for (size_t i = 0; i + 1 < circuit.size(); i++) {
+        assert(cycle.hasEdge(circuit[i], circuit[i + 1]));
+        walked.insert({circuit[i], circuit[i + 1]});
+    }
+    assert(walked.size() == 6);
+    
+    graph::Graph longCycle(1000000, true);
+    for (int v = 0; v < 1000000; v++) {
+        longCycle.addEdge(v, (v + 1) % 1000000);
+    }
+    assert(longCycle.findEulerCircuit().size() == 1000001);
+    
+    // Random directed generation: distinct ordered pairs, thread-independent
+    struct Case { int vertices; int edges; };
+    for (const Case& c : std::vector<Case>{{1000, 5000}, {30, 800}, {12, 1000}, {2, 2}, {900, 600000}}) {
+        auto edges = graph::Graph::generateRandomEdges(c.vertices, c.edges, 7, 1, true);
+        long long maxEdges = static_cast<long long>(c.vertices) * (c.vertices - 1);
+        assert(static_cast<long long>(edges.size()) == std::min<long long>(c.edges, maxEdges));
+        std::set<std::pair<int, int>> unique;
+        for (const auto& e : edges) {
+            assert(0 <= e.first && e.first < c.vertices && 0 <= e.second && e.second < c.vertices);
+            assert(e.first != e.second);
+            unique.insert(e);
+        }
+        assert(unique.size() == edges.size());
+        for (unsigned int threads : {2u, 0u}) {
+            assert(graph::Graph::generateRandomEdges(c.vertices, c.edges, 7, threads, true) == edges);
+        }
+        
+        graph::Graph random = graph::Graph::generateRandomGraph(c.vertices, c.edges, 7, 1, true);
+        graph::CSRGraph csr = graph::CSRGraph::generateRandomGraph(c.vertices, c.edges, 7, 1, true);
+        graph::CSRGraph snapshot(random);
+        assert(random.getNumEdges() == static_cast<int>(edges.size()));
+        assert(csr.isDirected() && csr.getNumEdges() == random.getNumEdges());
+        assert(csr.getDests() == snapshot.getDests() && csr.getOffsets() == snapshot.getOffsets());
+    }
+    
+    // Directed SCCs: a 3-cycle with a tail hanging off it
+    auto scc = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::SCC);
+    graph::CSRGraph tail = graph::CSRGraph::fromEdges(5, {{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}}, 1, true);
+    assert(tail.getNumEdges() == 5 && tail.transposed().getDegree(0) == 1);
+    assert(scc->execute(tail) == "Found 3 Strongly Connected Components:\n"
+                                 "SCC 1: {4}\n"
+                                 "SCC 2: {3}\n"
+                                 "SCC 3: {0, 1, 2}\n");
+    
+    // Flow only runs along edge direction
+    auto maxFlow = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MAX_FLOW);
+    auto pushRelabel = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MAX_FLOW_PR);
+    graph::Graph forward(3, true);
+    forward.addEdge(0, 1, 5);
+    forward.addEdge(1, 2, 3);
+    graph::Graph backward(3, true);
+    backward.addEdge(1, 0, 5);
+    backward.addEdge(2, 1, 3);
+    assert(maxFlow->execute(forward) == "Max Flow from node 0 to node 2: 3");
+    assert(maxFlow->execute(backward) == "Max Flow from node 0 to node 2: 0");
+    assert(pushRelabel->execute(forward) == "Max Flow from node 0 to node 2: 3");
+    assert(pushRelabel->execute(backward) == "Max Flow from node 0 to node 2: 0");
+    
+    // MST is undirected only; cliques use the underlying undirected graph
+    for (auto type : {graph::AlgorithmFactory::AlgorithmType::MST_WEIGHT,
+                      graph::AlgorithmFactory::AlgorithmType::MST_KRUSKAL,
+                      graph::AlgorithmFactory::AlgorithmType::MST_BORUVKA}) {
+        assert(graph::AlgorithmFactory::createAlgorithm(type)->execute(forward) == "MST requires an undirected graph");
+    }
+    auto maxClique = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MAX_CLIQUE);
+    graph::CSRGraph triangle = graph::CSRGraph::fromEdges(4, {{0, 1}, {1, 2}, {2, 0}, {1, 0}, {3, 0}}, 1, true);
+    assert(triangle.symmetrized().getNumEdges() == 4);
+    assert(maxClique->execute(triangle) == "Max Clique Size: 3\nMax Clique Vertices: {0, 1, 2}");
+    graph::CSRGraph randomDirected = graph::CSRGraph::generateRandomGraph(60, 1500, 3, 1, true);
+    assert(maxClique->execute(randomDirected) == maxClique->execute(randomDirected.symmetrized()));
+    
+    std::cout << "Directed graph tests passed!\n\n";
+}
+
 // Test comprehensive algorithm scenarios
 void testComprehensiveAlgorithms() {
     std::cout << "Testing Comprehensive Algorithms:\n";
@@ -217,8 +1321,11 @@ void testComprehensiveAlgorithms() {
     // Test all algorithms on each graph
     std::vector<graph::AlgorithmFactory::AlgorithmType> algorithms = {
         graph::AlgorithmFactory::AlgorithmType::MST_WEIGHT,
+        graph::AlgorithmFactory::AlgorithmType::MST_KRUSKAL,
+        graph::AlgorithmFactory::AlgorithmType::MST_BORUVKA,
         graph::AlgorithmFactory::AlgorithmType::SCC,
         graph::AlgorithmFactory::AlgorithmType::MAX_FLOW,
+        graph::AlgorithmFactory::AlgorithmType::MAX_FLOW_PR,
         graph::AlgorithmFactory::AlgorithmType::MAX_CLIQUE
     };
     
@@ -257,6 +1364,49 @@ int main() {
     // Test Graph edge cases
     testGraphEdgeCases();
     
+    // Test arena-backed adjacency
+    testNeighborArena();
+    
+    // Test cached counters
+    testCachedCounters();
+    
+    // Test random generation
+    testRandomGeneration();
+    
+    // Test Euler circuit at scale
+    testEulerCircuitLarge();
+    
+    // Test connected components
+    testConnectedComponents();
+    
+    // Test max flow
+    testSpanningForest();
+    testSCC();
+    testMaxFlow();
+    testWorkStealingPool();
+    testMaxClique();
+    
+    // Test typed results and their serializers
+    testAlgorithmResults();
+    
+    // Test the registry and direct dispatch
+    testAlgorithmRegistry();
+    
+    // Test per-thread scratch workspaces
+    testWorkspace();
+    
+    // Test time budgets and partial results
+    testCancellation();
+    
+    // Test move semantics
+    testGraphMoveSemantics();
+    
+    // Test CSR representation
+    testCSRGraph();
+    
+    // Test directed mode
+    testDirectedGraph();
+    
     // Test comprehensive algorithms
     testComprehensiveAlgorithms();
     
@@ -282,6 +1432,8 @@ int main() {
     // Test all algorithms using the Factory pattern
     std::vector<graph::AlgorithmFactory::AlgorithmType> algorithms = {
         graph::AlgorithmFactory::AlgorithmType::MST_WEIGHT,
+        graph::AlgorithmFactory::AlgorithmType::MST_KRUSKAL,
+        graph::AlgorithmFactory::AlgorithmType::MST_BORUVKA,
         graph::AlgorithmFactory::AlgorithmType::SCC,
         graph::AlgorithmFactory::AlgorithmType::MAX_FLOW,
         graph::AlgorithmFactory::AlgorithmType::MAX_CLIQUE
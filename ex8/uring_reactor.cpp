@@ -0,0 +1,461 @@
+#include "uring_reactor.hpp"
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+namespace graph {
+
+    // Buffer group the recv requests pick from
+    static const unsigned short BUFFER_GROUP = 0;
+    // Longest wait in io_uring_enter, so run() notices running dropping
+    static const long WAIT_NANOS = 100 * 1000 * 1000;
+
+    UringReactor::UringReactor(int listen_fd, RequestHandler onRequest) : listenFd(listen_fd), onRequest(std::move(onRequest)) {
+        io_uring_params params{};
+        ringFd = static_cast<int>(syscall(__NR_io_uring_setup, RING_ENTRIES, &params));
+        if (ringFd < 0) {
+            throw std::runtime_error(std::string("io_uring_setup: ") + strerror(errno));
+        }
+        unsigned int required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+        if ((params.features & required) != required) {
+            release();
+            throw std::runtime_error("io_uring lacks required features");
+        }
+        try {
+            probe();
+        } catch (const std::runtime_error&) {
+            release();
+            throw;
+        }
+
+        // Submission and completion rings share one mapping
+        ringSize = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned int),
+                            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+        ringMemory = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqeMemory = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (ringMemory == MAP_FAILED || sqeMemory == MAP_FAILED) {
+            if (ringMemory == MAP_FAILED) ringMemory = nullptr;
+            if (sqeMemory != MAP_FAILED) munmap(sqeMemory, sqesSize);
+            release();
+            throw std::runtime_error("Cannot map io_uring rings");
+        }
+        sqes = static_cast<io_uring_sqe*>(sqeMemory);
+        char* base = static_cast<char*>(ringMemory);
+        sqHead = reinterpret_cast<unsigned int*>(base + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned int*>(base + params.sq_off.tail);
+        sqArray = reinterpret_cast<unsigned int*>(base + params.sq_off.array);
+        sqMask = *reinterpret_cast<unsigned int*>(base + params.sq_off.ring_mask);
+        sqEntries = params.sq_entries;
+        localTail = *sqTail;
+        cqHead = reinterpret_cast<unsigned int*>(base + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned int*>(base + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned int*>(base + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+
+        bufferPool.reset(new char[static_cast<size_t>(BUFFER_COUNT) * BUFFER_SIZE]);
+        wakeFd = eventfd(0, EFD_CLOEXEC);
+        if (wakeFd < 0) {
+            release();
+            throw std::runtime_error("Cannot create eventfd");
+        }
+    }
+
+    UringReactor::~UringReactor() {
+        drain();
+        for (const auto& entry : connections) {
+            close(entry.first);
+        }
+        release();
+    }
+
+    // Cancel whatever the kernel still runs and wait for it, then take the
+    // provided buffers back, so nothing can write into bufferPool once it
+    // is freed
+    void UringReactor::drain() {
+        draining = true;
+        auto settle = [this] {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+            while (inFlight > 0 && std::chrono::steady_clock::now() < deadline) {
+                enter(true);
+                reap();
+            }
+        };
+        io_uring_sqe* sqe = nextSqe();
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+        sqe->user_data = tag(Op::CANCEL, 0);
+        settle();
+        sqe = nextSqe();
+        sqe->opcode = IORING_OP_REMOVE_BUFFERS;
+        sqe->fd = static_cast<int>(BUFFER_COUNT);
+        sqe->buf_group = BUFFER_GROUP;
+        sqe->user_data = tag(Op::PROVIDE, 0);
+        settle();
+        if (inFlight > 0) {
+            // Something would not finish; the kernel may still own buffers,
+            // so leak them rather than free memory it could write to
+            std::cerr << "io_uring: " << inFlight << " requests still pending at shutdown" << std::endl;
+            bufferPool.release();
+        }
+    }
+
+    // Ask the ring which operations it supports instead of trusting the
+    // kernel version: seccomp filters, container runtimes and backports all
+    // make the two disagree. Multishot accept (5.19) and the "more data"
+    // flag used for framing (6.0) have no opcode of their own; zero-copy
+    // send arrived in 6.0, so it stands in for both.
+    void UringReactor::probe() {
+        std::vector<char> memory(sizeof(io_uring_probe) + IORING_OP_LAST * sizeof(io_uring_probe_op));
+        io_uring_probe* ops = reinterpret_cast<io_uring_probe*>(memory.data());
+        if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, ops, IORING_OP_LAST) < 0) {
+            throw std::runtime_error(std::string("io_uring probe: ") + strerror(errno));
+        }
+        const int needed[] = {IORING_OP_ACCEPT, IORING_OP_RECV, IORING_OP_SEND, IORING_OP_CLOSE, IORING_OP_READ,
+                              IORING_OP_PROVIDE_BUFFERS, IORING_OP_REMOVE_BUFFERS, IORING_OP_ASYNC_CANCEL,
+                              IORING_OP_SEND_ZC};
+        for (int op : needed) {
+            if (op > ops->last_op || !(ops->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+                throw std::runtime_error("io_uring lacks operation " + std::to_string(op));
+            }
+        }
+    }
+
+    // Tear down whatever the constructor got as far as setting up
+    void UringReactor::release() {
+        if (ringFd >= 0) close(ringFd);
+        if (ringMemory) munmap(ringMemory, ringSize);
+        if (sqes) munmap(sqes, sqesSize);
+        if (wakeFd >= 0) close(wakeFd);
+        ringFd = wakeFd = -1;
+        ringMemory = nullptr;
+        sqes = nullptr;
+    }
+
+    void UringReactor::run(const volatile sig_atomic_t& running) {
+        provideBuffers(0, BUFFER_COUNT);
+        armAccept();
+        armWake();
+        while (running) {
+            enter(true);
+            reap();
+            expireIdle();
+        }
+    }
+
+    void UringReactor::respond(int client_fd, std::string response) {
+        {
+            std::lock_guard<std::mutex> lock(responseMutex);
+            responses.emplace_back(client_fd, std::move(response));
+        }
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0) {
+            perror("eventfd write");
+        }
+    }
+
+    // Make room for count more entries, submitting what is queued if needed
+    void UringReactor::reserve(unsigned int count) {
+        while (localTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) + count > sqEntries) {
+            enter(false);
+        }
+    }
+
+    // A zeroed entry at the tail; the kernel sees it at the next enter()
+    io_uring_sqe* UringReactor::nextSqe() {
+        reserve(1);
+        unsigned int index = localTail & sqMask;
+        io_uring_sqe* sqe = &sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqArray[index] = index;
+        localTail++;
+        toSubmit++;
+        inFlight++;
+        return sqe;
+    }
+
+    // Submit everything queued and, if wait, block until a completion
+    // arrives or WAIT_NANOS pass
+    void UringReactor::enter(bool wait) {
+        __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+        __kernel_timespec timeout{0, WAIT_NANOS};
+        io_uring_getevents_arg arg{};
+        arg.ts = reinterpret_cast<uint64_t>(&timeout);
+        unsigned int flags = IORING_ENTER_EXT_ARG | (wait ? IORING_ENTER_GETEVENTS : 0);
+        long ret = syscall(__NR_io_uring_enter, ringFd, toSubmit, wait ? 1 : 0, flags, &arg, sizeof(arg));
+        if (ret > 0) {
+            toSubmit -= std::min(static_cast<unsigned int>(ret), toSubmit);
+        } else if (ret < 0 && errno != ETIME && errno != EINTR && errno != EBUSY && errno != EAGAIN) {
+            perror("io_uring_enter");
+        }
+    }
+
+    // Handle every completion posted so far
+    void UringReactor::reap() {
+        unsigned int head = *cqHead;
+        unsigned int tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            io_uring_cqe cqe = cqes[head & cqMask];
+            head++;
+            if (!(cqe.flags & IORING_CQE_F_MORE)) {
+                inFlight--;
+            }
+            if (draining) {
+                continue;
+            }
+            int fd = static_cast<int>(static_cast<uint32_t>(cqe.user_data));
+            switch (static_cast<Op>(cqe.user_data >> 32)) {
+                case Op::ACCEPT:
+                    accepted(cqe.res, cqe.flags);
+                    break;
+                case Op::RECV:
+                    received(fd, cqe.res, cqe.flags);
+                    break;
+                case Op::SEND:
+                    sent(fd, cqe.res);
+                    break;
+                case Op::CLOSE:
+                    closed(fd, cqe.res);
+                    break;
+                case Op::WAKE:
+                    flushResponses();
+                    armWake();
+                    break;
+                case Op::PROVIDE:
+                    if (cqe.res < 0) std::cerr << "provide buffers: " << strerror(-cqe.res) << std::endl;
+                    break;
+                case Op::CANCEL:
+                    break;
+            }
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    // One request keeps accepting until it fails
+    void UringReactor::armAccept() {
+        io_uring_sqe* sqe = nextSqe();
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->fd = listenFd;
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe->accept_flags = SOCK_CLOEXEC;
+        sqe->user_data = tag(Op::ACCEPT, listenFd);
+    }
+
+    // The kernel picks the buffer when data arrives, so an idle
+    // connection holds none
+    void UringReactor::armRecv(int fd) {
+        io_uring_sqe* sqe = nextSqe();
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = fd;
+        sqe->len = BUFFER_SIZE;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = BUFFER_GROUP;
+        sqe->user_data = tag(Op::RECV, fd);
+    }
+
+    void UringReactor::armWake() {
+        io_uring_sqe* sqe = nextSqe();
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = wakeFd;
+        sqe->addr = reinterpret_cast<uint64_t>(&wakeValue);
+        sqe->len = sizeof(wakeValue);
+        sqe->user_data = tag(Op::WAKE, wakeFd);
+    }
+
+    // Send whatever is left, then close; a short or failed send cancels
+    // the close, and closed() picks up from there
+    void UringReactor::sendAndClose(int fd, Connection& conn) {
+        reserve(2); // The link must not be split across two submissions
+        io_uring_sqe* sendSqe = nextSqe();
+        sendSqe->opcode = IORING_OP_SEND;
+        sendSqe->fd = fd;
+        sendSqe->addr = reinterpret_cast<uint64_t>(conn.buffer.data() + conn.sent);
+        sendSqe->len = static_cast<uint32_t>(conn.buffer.size() - conn.sent);
+        sendSqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+        sendSqe->flags = IOSQE_IO_LINK;
+        sendSqe->user_data = tag(Op::SEND, fd);
+        io_uring_sqe* closeSqe = nextSqe();
+        closeSqe->opcode = IORING_OP_CLOSE;
+        closeSqe->fd = fd;
+        closeSqe->user_data = tag(Op::CLOSE, fd);
+    }
+
+    void UringReactor::closeFd(int fd) {
+        io_uring_sqe* sqe = nextSqe();
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = fd;
+        sqe->user_data = tag(Op::CLOSE, fd);
+    }
+
+    void UringReactor::accepted(int res, unsigned int flags) {
+        if (!(flags & IORING_CQE_F_MORE)) {
+            armAccept(); // The multishot request ended; start another
+        }
+        if (res < 0) {
+            if (res != -ECANCELED) std::cerr << "accept: " << strerror(-res) << std::endl;
+            return;
+        }
+
+        sockaddr_in addr{};
+        socklen_t len = sizeof(addr);
+        char ip[INET_ADDRSTRLEN] = "unknown";
+        if (getpeername(res, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+            inet_ntop(AF_INET, &addr.sin_addr, ip, INET_ADDRSTRLEN);
+        }
+        std::cout << "New connection from " << ip << ":" << ntohs(addr.sin_port) << std::endl;
+
+        Connection& conn = connections[res];
+        conn = Connection{};
+        conn.ip = ip;
+        conn.opened = std::chrono::steady_clock::now();
+        armRecv(res);
+    }
+
+    // Same framing as the epoll reactor: a request ends at a newline, or at
+    // the end of the data once the kernel reports the socket drained
+    void UringReactor::received(int fd, int res, unsigned int flags) {
+        auto it = connections.find(fd);
+        if (flags & IORING_CQE_F_BUFFER) {
+            unsigned int bid = flags >> IORING_CQE_BUFFER_SHIFT;
+            if (res > 0 && it != connections.end()) {
+                it->second.buffer.append(bufferPool.get() + static_cast<size_t>(bid) * BUFFER_SIZE, static_cast<size_t>(res));
+            }
+            provideBuffers(bid, 1);
+        }
+        if (it == connections.end() || it->second.state != State::READING) {
+            return;
+        }
+        Connection& conn = it->second;
+        if (res == -ENOBUFS || res == -EINTR || res == -EAGAIN) {
+            armRecv(fd); // Queued behind the buffers returned above
+            return;
+        }
+        bool peerClosed = res <= 0;
+        bool drained = !(flags & IORING_CQE_F_SOCK_NONEMPTY);
+
+        // Blank lines between requests carry nothing
+        size_t start = conn.buffer.find_first_not_of("\r\n");
+        conn.buffer.erase(0, start == std::string::npos ? conn.buffer.size() : start);
+        size_t end = conn.buffer.find('\n');
+        if (end == std::string::npos) {
+            if (!drained && !peerClosed && conn.buffer.size() < MAX_REQUEST_BYTES) {
+                armRecv(fd);
+                return;
+            }
+            end = std::min(conn.buffer.size(), MAX_REQUEST_BYTES);
+        }
+        if (end == 0) {
+            if (peerClosed || conn.buffer.size() >= MAX_REQUEST_BYTES) {
+                std::cout << "Error reading request from " << conn.ip << std::endl;
+                closeFd(fd);
+            } else {
+                armRecv(fd);
+            }
+            return;
+        }
+
+        // No recv stays armed while the request is out, so the socket is
+        // ours alone until the response is sent
+        conn.state = State::WAITING;
+        std::string request = conn.buffer.substr(0, std::min(end, MAX_REQUEST_BYTES));
+        conn.buffer.clear();
+        std::cout << "Received request from " << conn.ip << ": " << request << std::endl;
+        onRequest(fd, conn.ip, std::move(request));
+    }
+
+    void UringReactor::sent(int fd, int res) {
+        auto it = connections.find(fd);
+        if (it == connections.end()) {
+            return;
+        }
+        if (res > 0) {
+            it->second.sent += static_cast<size_t>(res);
+        } else if (res < 0) {
+            std::cerr << "send: " << strerror(-res) << std::endl;
+        }
+        it->second.sendFailed = res <= 0 && it->second.sent < it->second.buffer.size();
+    }
+
+    // A close cancelled by a short send resumes the send; one cancelled by
+    // a failed send closes on its own
+    void UringReactor::closed(int fd, int res) {
+        auto it = connections.find(fd);
+        if (it == connections.end()) {
+            return;
+        }
+        if (res == -ECANCELED) {
+            Connection& conn = it->second;
+            if (!conn.sendFailed && conn.sent < conn.buffer.size()) {
+                sendAndClose(fd, conn);
+            } else {
+                closeFd(fd);
+            }
+            return;
+        }
+        connections.erase(it);
+    }
+
+    // Hand buffers first..first+count-1 to the kernel. A returned buffer
+    // rides along with the next io_uring_enter, so it costs no syscall.
+    void UringReactor::provideBuffers(unsigned int first, unsigned int count) {
+        io_uring_sqe* sqe = nextSqe();
+        sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+        sqe->fd = static_cast<int>(count);
+        sqe->addr = reinterpret_cast<uint64_t>(bufferPool.get() + static_cast<size_t>(first) * BUFFER_SIZE);
+        sqe->len = BUFFER_SIZE;
+        sqe->off = first;
+        sqe->buf_group = BUFFER_GROUP;
+        sqe->user_data = tag(Op::PROVIDE, 0);
+    }
+
+    // Queue the sends for every response handed over since the last wake-up
+    void UringReactor::flushResponses() {
+        std::vector<std::pair<int, std::string>> batch;
+        {
+            std::lock_guard<std::mutex> lock(responseMutex);
+            batch.swap(responses);
+        }
+        for (auto& response : batch) {
+            auto it = connections.find(response.first);
+            if (it == connections.end() || it->second.state != State::WAITING) {
+                continue;
+            }
+            Connection& conn = it->second;
+            conn.buffer = std::move(response.second);
+            conn.sent = 0;
+            conn.state = State::WRITING;
+            sendAndClose(response.first, conn);
+        }
+    }
+
+    // Shut down connections still without a complete request after
+    // REQUEST_TIMEOUT; their pending recv then completes empty and closes
+    // them. The scan runs at most once a second.
+    void UringReactor::expireIdle() {
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastSweep < std::chrono::seconds(1)) {
+            return;
+        }
+        lastSweep = now;
+        for (auto& entry : connections) {
+            Connection& conn = entry.second;
+            if (conn.state == State::READING && now - conn.opened >= REQUEST_TIMEOUT) {
+                std::cout << "Timeout waiting for request from " << conn.ip << std::endl;
+                shutdown(entry.first, SHUT_RDWR);
+                conn.opened = now;
+            }
+        }
+    }
+
+} // namespace graph
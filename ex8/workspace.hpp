@@ -0,0 +1,153 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+namespace graph {
+
+// Per-vertex values that reset in O(1). Every slot remembers the epoch it
+// was last written in; slots from an older epoch read as the fill value, so
+// a reset only bumps the epoch and the next user pays for what it touches.
+template<typename T>
+class StampedArray {
+public:
+    // n slots, all reading as value; storage only ever grows
+    void reset(size_t n, const T& value) {
+        if (n > values.size()) {
+            values.resize(n);
+            stamps.resize(n, 0);
+        }
+        fill = value;
+        if (++epoch == 0) {
+            // Wrapped: clear the stamps once every 2^32 resets
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    bool touched(size_t i) const { return stamps[i] == epoch; }
+    const T& get(size_t i) const { return touched(i) ? values[i] : fill; }
+    void set(size_t i, const T& value) {
+        stamps[i] = epoch;
+        values[i] = value;
+    }
+    // Writable slot, set to the fill value on first access this epoch
+    T& operator[](size_t i) {
+        if (!touched(i)) {
+            set(i, fill);
+        }
+        return values[i];
+    }
+
+private:
+    std::vector<T> values;
+    std::vector<uint32_t> stamps;
+    uint32_t epoch = 0;
+    T fill{};
+};
+
+// Set of vertices with an O(1) clear: membership is "stamped this epoch"
+class StampedSet {
+public:
+    void reset(size_t n) {
+        if (n > stamps.size()) {
+            stamps.resize(n, 0);
+        }
+        if (++epoch == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    bool contains(size_t i) const { return stamps[i] == epoch; }
+    void insert(size_t i) { stamps[i] = epoch; }
+
+private:
+    std::vector<uint32_t> stamps;
+    uint32_t epoch = 0;
+};
+
+// Scratch memory that one thread lends to the algorithms it runs.
+// borrow<C>() hands out a C left over from an earlier call (or a new one)
+// and takes it back when the lease ends, so containers keep their capacity
+// and a thread serving many requests stops allocating once it has seen its
+// largest graph. Borrowed objects keep their old contents: clear or reset
+// them before use. Not thread-safe; every worker owns its own workspace,
+// and it must outlive the leases taken from it.
+class Workspace {
+    struct PoolBase {
+        virtual ~PoolBase() = default;
+    };
+
+    template<typename C>
+    struct Pool : PoolBase {
+        std::vector<std::unique_ptr<C>> idle;
+        size_t created = 0;
+    };
+
+public:
+    // Owns a borrowed object until it goes out of scope
+    template<typename C>
+    class Lease {
+    public:
+        Lease(Pool<C>& pool, std::unique_ptr<C> item) : pool(&pool), item(std::move(item)) {}
+        Lease(Lease&& other) noexcept = default;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease() {
+            if (item) {
+                pool->idle.push_back(std::move(item));
+            }
+        }
+
+        C& operator*() const { return *item; }
+        C* operator->() const { return item.get(); }
+
+    private:
+        Pool<C>* pool;
+        std::unique_ptr<C> item;
+    };
+
+    Workspace() = default;
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    template<typename C>
+    Lease<C> borrow() {
+        size_t id = typeId<C>();
+        if (id >= pools.size()) {
+            pools.resize(id + 1);
+        }
+        if (!pools[id]) {
+            pools[id] = std::make_unique<Pool<C>>();
+        }
+        Pool<C>& pool = static_cast<Pool<C>&>(*pools[id]);
+        if (pool.idle.empty()) {
+            // Room to take every object back without allocating in ~Lease
+            pool.idle.reserve(++pool.created);
+            return Lease<C>(pool, std::make_unique<C>());
+        }
+        std::unique_ptr<C> item = std::move(pool.idle.back());
+        pool.idle.pop_back();
+        return Lease<C>(pool, std::move(item));
+    }
+
+private:
+    // Dense id per borrowed type, shared by all workspaces
+    static size_t nextTypeId() {
+        static std::atomic<size_t> next(0);
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template<typename C>
+    static size_t typeId() {
+        static const size_t id = nextTypeId();
+        return id;
+    }
+
+    std::vector<std::unique_ptr<PoolBase>> pools;
+};
+
+} // namespace graph
@@ -0,0 +1,249 @@
+#include "algorithm_result.hpp"
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace graph {
+
+    // Append a decimal number without a temporary string
+    static void appendNumber(std::string& out, long long value) {
+        char buffer[24];
+        char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+        out.append(buffer, end);
+    }
+
+    // "{a, b, c}"
+    static void appendVertexList(std::string& out, const int* begin, const int* end) {
+        out += '{';
+        for (const int* v = begin; v != end; ++v) {
+            if (v != begin) out += ", ";
+            appendNumber(out, *v);
+        }
+        out += '}';
+    }
+
+    static const char* const PARTIAL_NOTE = " (partial: time budget exceeded)";
+
+    bool isPartial(const AlgorithmResult& result) {
+        if (const auto* flow = std::get_if<FlowResult>(&result)) {
+            return flow->partial;
+        }
+        if (const auto* clique = std::get_if<CliqueResult>(&result)) {
+            return clique->partial;
+        }
+        return false;
+    }
+
+    // Text serializer
+    void appendText(std::string& out, const AlgorithmResult& result) {
+        std::visit([&out](const auto& value) {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, NoticeResult>) {
+                out += value.message;
+            } else if constexpr (std::is_same_v<T, SpanningTreeResult>) {
+                if (value.connected) {
+                    out += "MST Weight: ";
+                    appendNumber(out, value.weight);
+                } else if (value.trees == 0) {
+                    out += "Graph is not connected - MST weight: ";
+                    appendNumber(out, value.weight);
+                } else {
+                    out += "Graph is not connected - spanning forest weight: ";
+                    appendNumber(out, value.weight);
+                    out += " (";
+                    appendNumber(out, value.trees);
+                    out += " trees)";
+                }
+            } else if constexpr (std::is_same_v<T, SCCResult>) {
+                size_t count = value.offsets.empty() ? 0 : value.offsets.size() - 1;
+                out += "Found ";
+                appendNumber(out, static_cast<long long>(count));
+                out += " Strongly Connected Components:\n";
+                for (size_t i = 0; i < count; i++) {
+                    out += "SCC ";
+                    appendNumber(out, static_cast<long long>(i + 1));
+                    out += ": ";
+                    appendVertexList(out, value.members.data() + value.offsets[i],
+                                     value.members.data() + value.offsets[i + 1]);
+                    out += '\n';
+                }
+            } else if constexpr (std::is_same_v<T, FlowResult>) {
+                out += "Max Flow from node ";
+                appendNumber(out, value.source);
+                out += " to node ";
+                appendNumber(out, value.sink);
+                out += ": ";
+                appendNumber(out, value.value);
+                if (value.partial) out += PARTIAL_NOTE;
+            } else {
+                out += "Max Clique Size: ";
+                appendNumber(out, static_cast<long long>(value.vertices.size()));
+                if (value.partial) out += PARTIAL_NOTE;
+                out += "\nMax Clique Vertices: ";
+                appendVertexList(out, value.vertices.data(), value.vertices.data() + value.vertices.size());
+            }
+        }, result);
+    }
+
+    std::string toText(const AlgorithmResult& result) {
+        std::string out;
+        appendText(out, result);
+        return out;
+    }
+
+    // Set in the tag byte of a partial result
+    static const std::uint8_t PARTIAL_BIT = 0x80;
+
+    // Little-endian fixed-width integer
+    template<typename T>
+    static void put(std::string& out, T value) {
+        auto bits = static_cast<std::make_unsigned_t<T>>(value);
+        for (size_t i = 0; i < sizeof(T); i++) {
+            out += static_cast<char>((bits >> (8 * i)) & 0xFF);
+        }
+    }
+
+    static void putVector(std::string& out, const std::vector<int>& values) {
+        put<std::uint32_t>(out, static_cast<std::uint32_t>(values.size()));
+        for (int v : values) {
+            put<std::int32_t>(out, v);
+        }
+    }
+
+    // Binary serializer
+    void appendBinary(std::string& out, const AlgorithmResult& result) {
+        put<std::uint8_t>(out, static_cast<std::uint8_t>(result.index() | (isPartial(result) ? PARTIAL_BIT : 0)));
+        std::visit([&out](const auto& value) {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, NoticeResult>) {
+                put<std::uint32_t>(out, static_cast<std::uint32_t>(value.message.size()));
+                out += value.message;
+            } else if constexpr (std::is_same_v<T, SpanningTreeResult>) {
+                put<std::int64_t>(out, value.weight);
+                put<std::uint8_t>(out, value.connected ? 1 : 0);
+                put<std::int32_t>(out, value.trees);
+            } else if constexpr (std::is_same_v<T, SCCResult>) {
+                putVector(out, value.offsets);
+                putVector(out, value.members);
+            } else if constexpr (std::is_same_v<T, FlowResult>) {
+                put<std::int32_t>(out, value.source);
+                put<std::int32_t>(out, value.sink);
+                put<std::int64_t>(out, value.value);
+            } else {
+                putVector(out, value.vertices);
+            }
+        }, result);
+    }
+
+    std::string toBinary(const AlgorithmResult& result) {
+        std::string out;
+        appendBinary(out, result);
+        return out;
+    }
+
+    namespace {
+
+    // Bounds-checked cursor over a serialized result
+    class BinaryReader {
+    public:
+        explicit BinaryReader(const std::string& bytes) : bytes(bytes), pos(0) {}
+
+        template<typename T>
+        T get() {
+            need(sizeof(T));
+            std::make_unsigned_t<T> bits = 0;
+            for (size_t i = 0; i < sizeof(T); i++) {
+                bits |= static_cast<std::make_unsigned_t<T>>(static_cast<unsigned char>(bytes[pos++])) << (8 * i);
+            }
+            return static_cast<T>(bits);
+        }
+
+        std::vector<int> getVector() {
+            std::uint32_t count = get<std::uint32_t>();
+            need(static_cast<size_t>(count) * 4);
+            std::vector<int> values(count);
+            for (int& v : values) {
+                v = get<std::int32_t>();
+            }
+            return values;
+        }
+
+        std::string getString() {
+            std::uint32_t count = get<std::uint32_t>();
+            need(count);
+            std::string value = bytes.substr(pos, count);
+            pos += count;
+            return value;
+        }
+
+        bool done() const {
+            return pos == bytes.size();
+        }
+
+    private:
+        const std::string& bytes;
+        size_t pos;
+
+        void need(size_t count) const {
+            if (bytes.size() - pos < count) {
+                throw std::invalid_argument("Truncated algorithm result");
+            }
+        }
+    };
+
+    } // namespace
+
+    AlgorithmResult fromBinary(const std::string& bytes) {
+        BinaryReader reader(bytes);
+        AlgorithmResult result;
+        std::uint8_t tag = reader.get<std::uint8_t>();
+        bool partial = (tag & PARTIAL_BIT) != 0;
+        switch (tag & ~PARTIAL_BIT) {
+            case 0:
+                result = NoticeResult{reader.getString()};
+                break;
+            case 1: {
+                long long weight = reader.get<std::int64_t>();
+                bool connected = reader.get<std::uint8_t>() != 0;
+                result = SpanningTreeResult{weight, connected, reader.get<std::int32_t>()};
+                break;
+            }
+            case 2: {
+                SCCResult scc;
+                scc.offsets = reader.getVector();
+                scc.members = reader.getVector();
+                if (!scc.offsets.empty() && (scc.offsets.front() != 0 ||
+                                             scc.offsets.back() != static_cast<int>(scc.members.size()))) {
+                    throw std::invalid_argument("Inconsistent component offsets");
+                }
+                for (size_t i = 1; i < scc.offsets.size(); i++) {
+                    if (scc.offsets[i] < scc.offsets[i - 1]) {
+                        throw std::invalid_argument("Inconsistent component offsets");
+                    }
+                }
+                result = std::move(scc);
+                break;
+            }
+            case 3: {
+                int source = reader.get<std::int32_t>();
+                int sink = reader.get<std::int32_t>();
+                result = FlowResult{source, sink, reader.get<std::int64_t>(), partial};
+                break;
+            }
+            case 4:
+                result = CliqueResult{reader.getVector(), partial};
+                break;
+            default:
+                throw std::invalid_argument("Unknown algorithm result tag");
+        }
+        if (partial && !isPartial(result)) {
+            throw std::invalid_argument("Partial flag on a result that cannot be partial");
+        }
+        if (!reader.done()) {
+            throw std::invalid_argument("Trailing bytes after algorithm result");
+        }
+        return result;
+    }
+
+} // namespace graph
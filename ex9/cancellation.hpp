@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+
+namespace graph {
+
+// Deadline and stop flag for one request, shared by every thread working on
+// it. Engines that can run for a long time poll it and, once it fires,
+// return the best result found so far flagged as partial.
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Fires only through cancel()
+    CancellationToken() : deadline(Clock::time_point::max()) {}
+    // Fires once budget has elapsed from now
+    explicit CancellationToken(std::chrono::milliseconds budget) : deadline(Clock::now() + budget) {}
+
+    CancellationToken(const CancellationToken&) = delete;
+    CancellationToken& operator=(const CancellationToken&) = delete;
+
+    void cancel() { stopped.store(true, std::memory_order_relaxed); }
+
+    // Reads the clock when a deadline is set; hot loops go through a
+    // CancellationPoller instead
+    bool expired() const {
+        if (stopped.load(std::memory_order_relaxed)) {
+            return true;
+        }
+        if (deadline != Clock::time_point::max() && Clock::now() >= deadline) {
+            stopped.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+private:
+    Clock::time_point deadline;
+    mutable std::atomic<bool> stopped{false};
+};
+
+// One thread's view of a token: asks the token only every STRIDE polls, so
+// a poll in an inner loop costs a decrement. Once fired it stays fired.
+// A default-constructed poller never fires.
+class CancellationPoller {
+public:
+    static constexpr unsigned int STRIDE = 256;
+
+    CancellationPoller() = default;
+    explicit CancellationPoller(const CancellationToken& token) : token(&token), countdown(1) {}
+
+    bool poll() {
+        if (fired) {
+            return true;
+        }
+        if (--countdown > 0) {
+            return false;
+        }
+        countdown = STRIDE;
+        fired = token != nullptr && token->expired();
+        return fired;
+    }
+
+    // Whether poll() has returned true
+    bool stopped() const { return fired; }
+
+private:
+    const CancellationToken* token = nullptr;
+    unsigned int countdown = STRIDE;
+    bool fired = false;
+};
+
+} // namespace graph
@@ -0,0 +1,109 @@
+#pragma once
+#include "work_stealing_pool.hpp"
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <climits>
+#include <random>
+#include <unordered_map>
+
+namespace graph {
+
+// Afforest connected components (Sutton et al.), shared by Graph and CSRGraph.
+// Every vertex starts as its own tree and each edge hooks the larger root
+// under the smaller one with a CAS, so a component ends up labelled with its
+// smallest vertex whatever the thread count. The first few neighbours of
+// every vertex are linked first, which usually forms the giant component;
+// its vertices then skip the rest of their lists, since each undirected edge
+// is seen again from its other end. Directed graphs link every arc and get
+// weakly connected components. The phases run on the work-stealing pool's
+// shared helper threads, and graphs of up to VERTICES_PER_TASK vertices
+// stay on the calling thread.
+//
+// forEachNeighbor(u, skip, limit, visit) calls visit(v) for the neighbours
+// at positions [skip, limit) of u's list.
+template<typename ForEachNeighbor>
+std::vector<int> connectedComponentLabels(int n, bool symmetric, unsigned int threads,
+                                          const ForEachNeighbor& forEachNeighbor) {
+    const int VERTICES_PER_TASK = 1 << 14;
+    const int NEIGHBOR_ROUNDS = 2;
+    const int SAMPLES = 1024;
+
+    size_t tasks = (static_cast<size_t>(n) + VERTICES_PER_TASK - 1) / VERTICES_PER_TASK;
+    WorkStealingPool pool(threads);
+    auto forEachVertex = [&](const auto& body) {
+        pool.run(tasks, [&](size_t task, unsigned int) {
+            int end = static_cast<int>(std::min<size_t>(n, (task + 1) * VERTICES_PER_TASK));
+            for (int v = static_cast<int>(task * VERTICES_PER_TASK); v < end; v++) {
+                body(v);
+            }
+        });
+    };
+
+    std::vector<std::atomic<int>> comp(n);
+    auto link = [&comp](int u, int v) {
+        int p1 = comp[u].load(std::memory_order_relaxed);
+        int p2 = comp[v].load(std::memory_order_relaxed);
+        while (p1 != p2) {
+            int high = std::max(p1, p2);
+            int low = p1 + p2 - high;
+            int parent = comp[high].load(std::memory_order_relaxed);
+            if (parent == low) {
+                break;
+            }
+            if (parent == high && comp[high].compare_exchange_strong(parent, low, std::memory_order_relaxed)) {
+                break;
+            }
+            p1 = comp[comp[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+            p2 = comp[low].load(std::memory_order_relaxed);
+        }
+    };
+    // Point v straight at its current root
+    auto compress = [&comp](int v) {
+        int parent = comp[v].load(std::memory_order_relaxed);
+        int grandparent = comp[parent].load(std::memory_order_relaxed);
+        while (parent != grandparent) {
+            comp[v].store(grandparent, std::memory_order_relaxed);
+            parent = grandparent;
+            grandparent = comp[parent].load(std::memory_order_relaxed);
+        }
+    };
+
+    forEachVertex([&](int v) { comp[v].store(v, std::memory_order_relaxed); });
+    for (int round = 0; round < NEIGHBOR_ROUNDS; round++) {
+        forEachVertex([&](int v) { forEachNeighbor(v, round, round + 1, [&](int w) { link(v, w); }); });
+        forEachVertex(compress);
+    }
+
+    // Guess the giant component from a fixed sample of vertices
+    int giant = -1;
+    if (symmetric) {
+        std::mt19937 gen(27491095);
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        std::unordered_map<int, int> counts;
+        int best = 0;
+        for (int i = 0; i < SAMPLES; i++) {
+            int label = comp[pick(gen)].load(std::memory_order_relaxed);
+            int count = ++counts[label];
+            if (count > best) {
+                best = count;
+                giant = label;
+            }
+        }
+    }
+
+    forEachVertex([&](int v) {
+        if (comp[v].load(std::memory_order_relaxed) != giant) {
+            forEachNeighbor(v, NEIGHBOR_ROUNDS, INT_MAX, [&](int w) { link(v, w); });
+        }
+    });
+    forEachVertex(compress);
+
+    std::vector<int> labels(n);
+    for (int v = 0; v < n; v++) {
+        labels[v] = comp[v].load(std::memory_order_relaxed);
+    }
+    return labels;
+}
+
+} // namespace graph
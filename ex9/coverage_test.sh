@@ -22,18 +22,24 @@ CXXFLAGS="-std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage" make clean
 # Compile individual object files with coverage
 echo "Compiling source files with coverage..."
 g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c graph.cpp -o graph.o
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c csr_graph.cpp -o csr_graph.o
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c work_stealing_pool.cpp -o work_stealing_pool.o
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c algorithm_result.cpp -o algorithm_result.o
 g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c point.cpp -o point.o
 g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c graph_algorithms.cpp -o graph_algorithms.o
 g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c test_algorithms.cpp -o test_algorithms.o
 g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c tcp_server.cpp -o tcp_server.o
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c io_engine.cpp -o io_engine.o
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c reactor.cpp -o reactor.o
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage -c uring_reactor.cpp -o uring_reactor.o
 
 # Link test executable with coverage library
 echo "Linking test executable with coverage..."
-g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage graph.o point.o graph_algorithms.o test_algorithms.o -o test_algorithms
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage graph.o csr_graph.o work_stealing_pool.o algorithm_result.o point.o graph_algorithms.o test_algorithms.o -o test_algorithms -pthread
 
 # Link server executable with coverage library
 echo "Linking server executable with coverage..."
-g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage tcp_server.o graph.o point.o graph_algorithms.o -o tcp_server -pthread
+g++ -std=c++17 -Wall -Wextra -Wpedantic -g -O0 --coverage tcp_server.o io_engine.o reactor.o uring_reactor.o graph.o csr_graph.o work_stealing_pool.o algorithm_result.o point.o graph_algorithms.o -o tcp_server -pthread
 
 if [ $? -ne 0 ]; then
     echo "ERROR: Build failed!"
@@ -75,7 +81,7 @@ echo "Generating coverage reports for YOUR source files only..."
 echo "========================================"
 
 # Only process YOUR source files, not external libraries
-YOUR_SOURCE_FILES=("graph.cpp" "point.cpp" "graph_algorithms.cpp" "tcp_server.cpp")
+YOUR_SOURCE_FILES=("graph.cpp" "csr_graph.cpp" "work_stealing_pool.cpp" "algorithm_result.cpp" "point.cpp" "graph_algorithms.cpp" "tcp_server.cpp" "io_engine.cpp" "reactor.cpp" "uring_reactor.cpp")
 
 for src_file in "${YOUR_SOURCE_FILES[@]}"; do
     if [ -f "$src_file" ]; then
@@ -139,7 +145,13 @@ echo "  - Lines starting with numbers show execution count"
 echo
 echo "Coverage summary:"
 echo "  - graph.cpp.gcov - Graph implementation coverage"
+echo "  - csr_graph.cpp.gcov - CSR graph coverage"
+echo "  - work_stealing_pool.cpp.gcov - Work-stealing pool coverage"
+echo "  - algorithm_result.cpp.gcov - Result serializer coverage"
 echo "  - point.cpp.gcov - Point class coverage"
 echo "  - graph_algorithms.cpp.gcov - Algorithm implementations coverage"
 echo "  - tcp_server.cpp.gcov - Server implementation coverage"
+echo "  - io_engine.cpp.gcov - I/O engine selection coverage"
+echo "  - reactor.cpp.gcov - epoll front end coverage"
+echo "  - uring_reactor.cpp.gcov - io_uring front end coverage"
 echo
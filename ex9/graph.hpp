@@ -1,6 +1,9 @@
 #pragma once
 #include <vector>
 #include <random>
+#include <memory>
+#include <utility>
+#include <cstddef>
 
 namespace graph {
 
@@ -11,19 +14,58 @@ struct Neighbor {
     Neighbor(int d, int w, Neighbor* n = nullptr) : dest(d), weight(w), next(n) {}
 };
 
+// Slab allocator for the Neighbor nodes of a single Graph.
+// Nodes are carved out of large blocks by bumping an index, removed nodes are
+// recycled through a free list, and all blocks are released in one go.
+class NeighborArena {
+public:
+    explicit NeighborArena(std::size_t capacity = 0);
+    NeighborArena(const NeighborArena&) = delete;
+    NeighborArena& operator=(const NeighborArena&) = delete;
+    NeighborArena(NeighborArena&& other) noexcept;
+    NeighborArena& operator=(NeighborArena&& other) noexcept;
+    ~NeighborArena();
+    
+    Neighbor* allocate(int dest, int weight, Neighbor* next = nullptr);
+    void deallocate(Neighbor* node);
+    // Make sure the next `nodes` allocations come from a single block
+    void reserve(std::size_t nodes);
+    void release();
+    
+private:
+    struct Block {
+        Neighbor* nodes;
+        std::size_t capacity;
+    };
+    
+    std::vector<Block> blocks;
+    std::size_t used;       // Nodes handed out from blocks.back()
+    Neighbor* freeList;     // Recycled nodes chained through Neighbor::next
+    
+    void addBlock(std::size_t capacity);
+};
+
 class Graph {
 private:
     int numVertices;
     Neighbor** adjList;
+    NeighborArena arena;
+    std::vector<int> degrees;  // Maintained by addEdge/removeEdge (out-degrees when directed)
+    std::vector<int> inDegrees;  // Directed graphs only
+    int numEdges;
+    bool directed;  // Store each edge once, as src -> dest
     
-    // Helper functions for Euler circuit algorithm
-    void dfs(int vertex, std::vector<bool>& visited) const;
-    void hierholzerDFS(int vertex, std::vector<int>& circuit, Graph& tempGraph) const;
+    void addRandomEdges(int edges, unsigned int seed, unsigned int threads);
+    // Insert an edge known to be new and valid (bulk loading)
+    void addEdgeUnchecked(int src, int dest, int weight);
 
 public:
-    Graph(int n);
+    Graph(int n, bool directed = false);
     Graph(const Graph& other);
     Graph& operator=(const Graph& other);
+    // Moves steal the adjacency lists and arena; the source is left empty
+    Graph(Graph&& other) noexcept;
+    Graph& operator=(Graph&& other) noexcept;
     void addEdge(int src, int dest, int weight = 1);
     void removeEdge(int src, int dest);
     void print_graph() const;
@@ -33,13 +75,26 @@ public:
     int getEdgeWeight(int src, int dest) const;
     void display() const;
     int getDegree(int vertex) const;
+    int getInDegree(int vertex) const;
     int getNumEdges() const;
-    bool isConnected() const;
-    bool hasEulerCircuit() const;
-    std::vector<int> findEulerCircuit() const;
+    bool isDirected() const;
+    // Connectivity checks label components on `threads` workers (0 = all cores)
+    std::vector<int> connectedComponents(unsigned int threads = 1) const;
+    bool isConnected(unsigned int threads = 1) const;
+    bool hasEulerCircuit(unsigned int threads = 1) const;
+    std::vector<int> findEulerCircuit(unsigned int threads = 1) const;
     
-    // Static function to generate random graph
-    static Graph generateRandomGraph(int vertices, int edges, unsigned int seed);
+    // Static function to generate random graph. Sampling runs on `threads`
+    // workers (0 = all cores); the result depends only on the seed.
+    // Directed graphs draw ordered pairs, so u -> v and v -> u are distinct.
+    static Graph generateRandomGraph(int vertices, int edges, unsigned int seed, unsigned int threads = 1,
+                                     bool directed = false);
+    // Same graph, built directly in heap storage owned by the caller
+    static std::unique_ptr<Graph> createRandomGraph(int vertices, int edges, unsigned int seed, unsigned int threads = 1,
+                                                    bool directed = false);
+    // Edge sequence behind generateRandomGraph, for building other representations
+    static std::vector<std::pair<int, int>> generateRandomEdges(int vertices, int edges, unsigned int seed,
+                                                                unsigned int threads = 1, bool directed = false);
     
     // Destructor - חייב להיות PUBLIC!
     ~Graph();
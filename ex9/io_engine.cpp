@@ -0,0 +1,33 @@
+#include "io_engine.hpp"
+#include "reactor.hpp"
+#include "uring_reactor.hpp"
+#include <iostream>
+#include <stdexcept>
+
+namespace graph {
+
+    std::unique_ptr<IoEngine> IoEngine::create(Backend preferred, int listen_fd, RequestHandler onRequest) {
+        if (preferred == Backend::IO_URING) {
+            try {
+                return std::unique_ptr<IoEngine>(new UringReactor(listen_fd, onRequest));
+            } catch (const std::runtime_error& e) {
+                // Kernels built without io_uring or too old for the operations
+                // used, and io_uring disabled by sysctl or seccomp, end up here
+                std::cerr << e.what() << ", falling back to epoll" << std::endl;
+            }
+        }
+        return std::unique_ptr<IoEngine>(new Reactor(listen_fd, std::move(onRequest)));
+    }
+
+    bool parseBackend(const std::string& text, IoEngine::Backend& backend) {
+        if (text == "epoll") {
+            backend = IoEngine::Backend::EPOLL;
+        } else if (text == "uring") {
+            backend = IoEngine::Backend::IO_URING;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+} // namespace graph
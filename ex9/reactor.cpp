@@ -0,0 +1,242 @@
+#include "reactor.hpp"
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace graph {
+
+    Reactor::Reactor(int listen_fd, RequestHandler onRequest) : listenFd(listen_fd), onRequest(std::move(onRequest)) {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epollFd < 0 || wakeFd < 0) {
+            if (epollFd >= 0) close(epollFd);
+            if (wakeFd >= 0) close(wakeFd);
+            throw std::runtime_error("Cannot create epoll instance");
+        }
+        fcntl(listenFd, F_SETFL, fcntl(listenFd, F_GETFL) | O_NONBLOCK);
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+        event.data.fd = wakeFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+    }
+
+    Reactor::~Reactor() {
+        for (const auto& entry : connections) {
+            close(entry.first);
+        }
+        close(wakeFd);
+        close(epollFd);
+    }
+
+    void Reactor::run(const volatile sig_atomic_t& running) {
+        epoll_event events[64];
+        while (running) {
+            // Wake up now and then to notice running and idle connections
+            int ready = epoll_wait(epollFd, events, 64, 100);
+            if (ready < 0) {
+                if (errno != EINTR) perror("epoll_wait");
+                continue;
+            }
+            for (int i = 0; i < ready; i++) {
+                int fd = events[i].data.fd;
+                if (fd == listenFd) {
+                    acceptAll();
+                    continue;
+                }
+                if (fd == wakeFd) {
+                    uint64_t count;
+                    while (read(wakeFd, &count, sizeof(count)) > 0) {}
+                    flushResponses();
+                    continue;
+                }
+                auto it = connections.find(fd);
+                if (it == connections.end()) {
+                    continue;
+                }
+                if (it->second.state == State::READING) {
+                    readable(fd, it->second);
+                } else if (it->second.state == State::WRITING) {
+                    writable(fd, it->second);
+                }
+            }
+            expireIdle();
+        }
+    }
+
+    void Reactor::respond(int client_fd, std::string response) {
+        {
+            std::lock_guard<std::mutex> lock(responseMutex);
+            responses.emplace_back(client_fd, std::move(response));
+        }
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+            perror("eventfd write");
+        }
+    }
+
+    // Take every pending connection; the listening socket is non-blocking
+    void Reactor::acceptAll() {
+        while (true) {
+            sockaddr_in addr{};
+            socklen_t len = sizeof(addr);
+            int fd = accept4(listenFd, reinterpret_cast<sockaddr*>(&addr), &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK) perror("accept");
+                return;
+            }
+
+            char ip[INET_ADDRSTRLEN];
+            inet_ntop(AF_INET, &addr.sin_addr, ip, INET_ADDRSTRLEN);
+            std::cout << "New connection from " << ip << ":" << ntohs(addr.sin_port) << std::endl;
+
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.fd = fd;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+                perror("epoll_ctl");
+                close(fd);
+                continue;
+            }
+            Connection& conn = connections[fd];
+            conn.ip = ip;
+            conn.opened = std::chrono::steady_clock::now();
+        }
+    }
+
+    // Read everything available. A request ends at a newline, or - since the
+    // client sends each request as one unterminated write - at the end of
+    // the data once the socket has been drained.
+    void Reactor::readable(int fd, Connection& conn) {
+        char chunk[4096];
+        bool peerClosed = false;
+        while (conn.buffer.size() < MAX_REQUEST_BYTES) {
+            ssize_t got = recv(fd, chunk, sizeof(chunk), 0);
+            if (got > 0) {
+                conn.buffer.append(chunk, static_cast<size_t>(got));
+                continue;
+            }
+            if (got == 0) {
+                peerClosed = true;
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                peerClosed = true;
+            }
+            break;
+        }
+
+        // Blank lines between requests carry nothing
+        size_t start = conn.buffer.find_first_not_of("\r\n");
+        conn.buffer.erase(0, start == std::string::npos ? conn.buffer.size() : start);
+        size_t end = conn.buffer.find('\n');
+        if (end == std::string::npos) {
+            end = std::min(conn.buffer.size(), MAX_REQUEST_BYTES);
+        }
+        if (end == 0) {
+            if (peerClosed || conn.buffer.size() >= MAX_REQUEST_BYTES) {
+                std::cout << "Error reading request from " << conn.ip << std::endl;
+                closeConnection(fd);
+            }
+            return;
+        }
+
+        // Out of epoll until the response comes back, so a hang-up in the
+        // meantime cannot spin the loop; the fd stays open for the response
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        conn.state = State::WAITING;
+        std::string request = conn.buffer.substr(0, std::min(end, MAX_REQUEST_BYTES));
+        conn.buffer.clear();
+        std::cout << "Received request from " << conn.ip << ": " << request << std::endl;
+        onRequest(fd, conn.ip, std::move(request));
+    }
+
+    // Send as much as the socket takes; close once everything is out
+    void Reactor::writable(int fd, Connection& conn) {
+        while (conn.sent < conn.buffer.size()) {
+            ssize_t put = send(fd, conn.buffer.data() + conn.sent, conn.buffer.size() - conn.sent, MSG_NOSIGNAL);
+            if (put > 0) {
+                conn.sent += static_cast<size_t>(put);
+                continue;
+            }
+            if (put < 0 && errno == EINTR) {
+                continue;
+            }
+            if (put < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return;
+            }
+            perror("send");
+            break;
+        }
+        closeConnection(fd);
+    }
+
+    // Start writing every response handed over since the last wake-up
+    void Reactor::flushResponses() {
+        std::vector<std::pair<int, std::string>> batch;
+        {
+            std::lock_guard<std::mutex> lock(responseMutex);
+            batch.swap(responses);
+        }
+        for (auto& response : batch) {
+            auto it = connections.find(response.first);
+            if (it == connections.end() || it->second.state != State::WAITING) {
+                continue;
+            }
+            Connection& conn = it->second;
+            conn.buffer = std::move(response.second);
+            conn.sent = 0;
+            conn.state = State::WRITING;
+            writable(response.first, conn);
+
+            // Short write: let epoll say when the rest fits
+            it = connections.find(response.first);
+            if (it != connections.end()) {
+                epoll_event event{};
+                event.events = EPOLLOUT;
+                event.data.fd = response.first;
+                epoll_ctl(epollFd, EPOLL_CTL_ADD, response.first, &event);
+            }
+        }
+    }
+
+    // Close connections still without a complete request after
+    // REQUEST_TIMEOUT; the scan runs at most once a second
+    void Reactor::expireIdle() {
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastSweep < std::chrono::seconds(1)) {
+            return;
+        }
+        lastSweep = now;
+        std::vector<int> expired;
+        for (const auto& entry : connections) {
+            if (entry.second.state == State::READING && now - entry.second.opened >= REQUEST_TIMEOUT) {
+                expired.push_back(entry.first);
+            }
+        }
+        for (int fd : expired) {
+            std::cout << "Timeout waiting for request from " << connections[fd].ip << std::endl;
+            closeConnection(fd);
+        }
+    }
+
+    void Reactor::closeConnection(int fd) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    }
+
+} // namespace graph
@@ -0,0 +1,214 @@
+#pragma once
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace graph {
+
+// Bounded lock-free multi-producer/multi-consumer queue.
+// Every cell carries a sequence number saying whether it is waiting for a
+// producer or a consumer of the current lap, so a push or pop is one CAS
+// on a position counter plus a release store, and no lock is held while a
+// value moves. Blocking calls spin briefly before sleeping on a futex, and
+// the wake syscall is only made when somebody is actually asleep. A full
+// queue blocks push(), which throttles producers instead of growing.
+// T must be default-constructible and move-assignable.
+template<typename T>
+class RingBuffer {
+public:
+    // Polls before a blocking call goes to sleep
+    static constexpr unsigned int SPIN_LIMIT = 128;
+
+    // capacity is rounded up to a power of two
+    explicit RingBuffer(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // Approximate while other threads are pushing or popping
+    size_t size() const {
+        size_t tailPos = tail.load(std::memory_order_relaxed);
+        size_t headPos = head.load(std::memory_order_relaxed);
+        return tailPos > headPos ? tailPos - headPos : 0;
+    }
+
+    // Non-blocking; value is moved from only on success
+    bool tryPush(T& value) {
+        if (!enqueue(value)) {
+            return false;
+        }
+        signal(items);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        if (!dequeue(value)) {
+            return false;
+        }
+        signal(spaces);
+        return true;
+    }
+
+    // Wait for a free cell; false, with value untouched, once closed
+    bool push(T& value) {
+        if (!wait(spaces, [&] { return enqueue(value); })) {
+            return false;
+        }
+        signal(items);
+        return true;
+    }
+
+    // Wait for a value; false once closed
+    bool pop(T& value) {
+        if (!wait(items, [&] { return dequeue(value); })) {
+            return false;
+        }
+        signal(spaces);
+        return true;
+    }
+
+    // Fail every blocked and future push/pop. Values still queued stay
+    // reachable through tryPop so the owner can release them.
+    void close() {
+        closed.store(true, std::memory_order_seq_cst);
+        for (Event* event : {&items, &spaces}) {
+            event->word.fetch_add(1, std::memory_order_seq_cst);
+            futex(event->word, FUTEX_WAKE_PRIVATE, INT_MAX);
+        }
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value{};
+    };
+
+    // Futex word bumped on every signal, plus how many threads sleep on it
+    struct Event {
+        alignas(64) std::atomic<uint32_t> word{0};
+        std::atomic<int> waiters{0};
+    };
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit integer");
+
+    // Cell pos is free for this lap when its sequence equals pos
+    bool enqueue(T& value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Full: the consumer of the last lap has not been here yet
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Cell pos holds a value when its sequence equals pos + 1
+    bool dequeue(T& value) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // Empty
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static void futex(std::atomic<uint32_t>& word, int op, uint32_t value) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), op, value, nullptr, nullptr, 0);
+    }
+
+    static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    // The bump and the waiter check are ordered against a sleeper's
+    // registration and word read, so either the sleeper sees the new word
+    // (and the value published before it) or the signaller sees the sleeper
+    static void signal(Event& event) {
+        event.word.fetch_add(1, std::memory_order_seq_cst);
+        if (event.waiters.load(std::memory_order_seq_cst) > 0) {
+            futex(event.word, FUTEX_WAKE_PRIVATE, 1);
+        }
+    }
+
+    // Retry attempt until it succeeds: spin first, then sleep until event
+    // is signalled; false once the queue is closed
+    template<typename Attempt>
+    bool wait(Event& event, Attempt attempt) {
+        for (unsigned int spin = 0; spin < SPIN_LIMIT; spin++) {
+            if (closed.load(std::memory_order_acquire)) {
+                return false;
+            }
+            if (attempt()) {
+                return true;
+            }
+            cpuRelax();
+        }
+        while (true) {
+            event.waiters.fetch_add(1, std::memory_order_seq_cst);
+            uint32_t seen = event.word.load(std::memory_order_seq_cst);
+            bool stop = closed.load(std::memory_order_seq_cst);
+            bool done = !stop && attempt();
+            if (!stop && !done) {
+                futex(event.word, FUTEX_WAIT_PRIVATE, seen);
+            }
+            event.waiters.fetch_sub(1, std::memory_order_relaxed);
+            if (stop) {
+                return false;
+            }
+            if (done) {
+                return true;
+            }
+        }
+    }
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    alignas(64) std::atomic<size_t> head{0};  // Next position to pop
+    alignas(64) std::atomic<size_t> tail{0};  // Next position to push
+    Event items;   // Signalled after a push
+    Event spaces;  // Signalled after a pop
+    std::atomic<bool> closed{false};
+};
+
+} // namespace graph
@@ -2,6 +2,7 @@
 #include <string>
 #include <memory>
 #include <cstring>
+#include <cstdlib>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -13,20 +14,38 @@
 #include <thread>
 #include <mutex>
 #include <chrono>
-#include <condition_variable>
-#include <queue>
 #include <atomic>
 #include <functional>
 #include <sstream>
 #include "graph.hpp"
+#include "csr_graph.hpp"
 #include "graph_algorithm.hpp"
+#include "ring_buffer.hpp"
+#include "io_engine.hpp"
 
-#define BACKLOG 5
+#define BACKLOG SOMAXCONN
 #define PIPELINE_STAGES 6  // Request Handler, MST, SCC, MAX_FLOW, MAX_CLIQUE, Response Sender
+#define ALGORITHM_STAGES 4 // MST, SCC, MAX_FLOW, MAX_CLIQUE - fanned out in parallel
+#define QUEUE_CAPACITY 1024 // Requests a stage queue holds before its producers block
+#define MAX_STAGE_WORKERS 256       // Upper bound for -w and -A
+#define AUTOSCALE_INTERVAL_MS 200   // How often the autoscaler samples the stages
 
 // Global variables for server control
 volatile sig_atomic_t running = 1;
-int listen_socket_fd = -1;
+
+// Stage names for -w, indexed like the stage ids
+const char* const STAGE_NAMES[PIPELINE_STAGES] = {"REQUEST", "MST", "SCC", "MAX_FLOW", "MAX_CLIQUE", "RESPONSE"};
+
+// Hands a finished response for client_fd back to the front end, which
+// sends it and closes the connection; callable from any stage thread
+using ResponseSink = std::function<void(int client_fd, std::string response)>;
+
+// Worker threads per stage, from the command line
+struct PipelineConfig {
+    unsigned int workers[PIPELINE_STAGES] = {3, 1, 1, 1, 1, 1};
+    unsigned int autoscale_max = 0;    // -A: grow busy stages up to this many workers; 0 = fixed counts
+    graph::IoEngine::Backend backend = graph::IoEngine::Backend::EPOLL;   // -i
+};
 
 void analyzeGraph(const graph::Graph& g) {
     std::cout << "\n" << std::string(50, '=') << "\n";
@@ -49,19 +68,19 @@ void analyzeGraph(const graph::Graph& g) {
         std::cout << "\n";
     }
     
-    std::cout << "\nConnectivity: " << (g.isConnected() ? "Connected" : "Disconnected") << "\n";
+    std::cout << "\nConnectivity: " << (g.isConnected(0) ? "Connected" : "Disconnected") << "\n";
     std::cout << "All degrees even: " << (allEven ? "Yes" : "No") << "\n";
     
     std::cout << "\n" << std::string(30, '-') << "\n";
     std::cout << "EULER CIRCUIT ANALYSIS\n";
     std::cout << std::string(30, '-') << "\n";
     
-    if (g.hasEulerCircuit()) {
+    if (g.hasEulerCircuit(0)) {
         std::cout << "✓ Euler circuit EXISTS!\n";
         std::cout << "Finding Euler circuit...\n";
         
         auto start = std::chrono::high_resolution_clock::now();
-        std::vector<int> circuit = g.findEulerCircuit();
+        std::vector<int> circuit = g.findEulerCircuit(0);
         auto end = std::chrono::high_resolution_clock::now();
         
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
@@ -76,7 +95,7 @@ void analyzeGraph(const graph::Graph& g) {
         std::cout << "Circuit length: " << circuit.size() << " vertices\n";
     } else {
         std::cout << "✗ No Euler circuit exists\n";
-        if (!g.isConnected()) {
+        if (!g.isConnected(0)) {
             std::cout << "Reason: Graph is not connected\n";
         } else if (!allEven) {
             std::cout << "Reason: Not all vertices have even degree\n";
@@ -94,107 +113,218 @@ std::string trim(const std::string& str) {
     return str.substr(start, end - start + 1);
 }
 
+// Output of one algorithm stage, kept typed until the response is written
+struct StageResult {
+    std::string title;              // Section heading, e.g. "MST WEIGHT"
+    std::string name;               // GraphAlgorithm::getName()
+    graph::AlgorithmResult value;
+    std::string error;              // Set instead of value when the stage failed
+};
+
 // Pipeline stage data structure
 struct PipelineData {
     int client_fd;
     std::string client_ip;
     std::string request;
     std::string algorithm;
+    int vertices = 0, edges = 0, seed = 0;
+    bool directed = false;
+    int budget_ms = 0;                     // -t <ms>, 0 = unlimited
+    std::unique_ptr<graph::CancellationToken> cancel;  // Shared deadline for all stages
     std::unique_ptr<graph::Graph> graph;
-    std::string result;
+    std::unique_ptr<graph::CSRGraph> csr;  // Read-only snapshot shared by the algorithm stages
+    bool has_euler_circuit = false;
+    std::vector<int> euler_circuit;
+    std::vector<StageResult> stages;       // One slot per algorithm stage, in response order
+    std::atomic<int> pending_stages{0};    // Algorithm stages still running; the last one joins
     std::chrono::high_resolution_clock::time_point start_time;
     
     PipelineData(int fd, const std::string& ip, const std::string& req) 
-        : client_fd(fd), client_ip(ip), request(req), graph(nullptr), start_time(std::chrono::high_resolution_clock::now()) {}
+        : client_fd(fd), client_ip(ip), request(req), graph(nullptr), csr(nullptr), start_time(std::chrono::high_resolution_clock::now()) {}
+};
+
+// Serialize everything the stages collected - the only place results become text
+std::string formatResponse(const PipelineData& data, long long micros) {
+    size_t estimate = 256 + 8 * data.euler_circuit.size();
+    for (const StageResult& stage : data.stages) {
+        estimate += 128;
+        if (const auto* scc = std::get_if<graph::SCCResult>(&stage.value)) {
+            estimate += 8 * scc->members.size() + 16 * scc->offsets.size();
+        }
+    }
+    std::string response;
+    response.reserve(estimate);
+    
+    response += "GRAPH ANALYSIS RESULTS:\n";
+    response += "Vertices: " + std::to_string(data.vertices) + "\n";
+    response += "Edges: " + std::to_string(data.edges) + "\n";
+    response += "Seed: " + std::to_string(data.seed) + "\n";
+    response += std::string("Directed: ") + (data.directed ? "yes" : "no") + "\n";
+    if (data.budget_ms > 0) {
+        response += "Time budget: " + std::to_string(data.budget_ms) + " ms\n";
+    }
+    response += "\n";
+    if (data.has_euler_circuit) {
+        response += "EULER CIRCUIT: SUCCESS!\n";
+        response += "Circuit: ";
+        for (size_t i = 0; i < data.euler_circuit.size(); ++i) {
+            if (i > 0) response += " -> ";
+            response += std::to_string(data.euler_circuit[i]);
+        }
+        response += "\n";
+    } else {
+        response += "EULER CIRCUIT: NOT POSSIBLE\n";
+        response += data.directed ? "Reason: Graph is not connected or some in-degree differs from its out-degree\n"
+                                  : "Reason: Graph is not connected or has odd-degree vertices\n";
+    }
+    response += "\n";
+    
+    for (const StageResult& stage : data.stages) {
+        if (!stage.error.empty()) {
+            response += "ERROR: " + stage.error + "\n\n";
+            continue;
+        }
+        response += "=== " + stage.title + " ALGORITHM ===\n";
+        response += stage.name + "\n";
+        response += "Result: ";
+        graph::appendText(response, stage.value);
+        response += "\n\n";
+    }
+    
+    response += "\n\nPipeline processing time: " + std::to_string(micros) + " microseconds\n";
+    return response;
+}
+
+// Workers and accumulated service time of one stage, sampled by the autoscaler
+struct StageLoad {
+    std::atomic<unsigned int> workers{0};
+    std::atomic<long long> busy_ns{0};
+};
+
+// Adds the time until stop(), or the end of the scope, to a stage's busy time
+class BusyTimer {
+public:
+    explicit BusyTimer(StageLoad& load) : load(load), start(std::chrono::steady_clock::now()) {}
+    ~BusyTimer() { stop(); }
+    
+    void stop() {
+        if (stopped) return;
+        stopped = true;
+        load.busy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+private:
+    StageLoad& load;
+    std::chrono::steady_clock::time_point start;
+    bool stopped = false;
 };
 
 // Pipeline Pattern Implementation
 class PipelineServer {
 private:
-    // Queues for each pipeline stage
-    std::queue<std::shared_ptr<PipelineData>> request_queue;
-    std::queue<std::shared_ptr<PipelineData>> mst_queue;
-    std::queue<std::shared_ptr<PipelineData>> scc_queue;
-    std::queue<std::shared_ptr<PipelineData>> max_flow_queue;
-    std::queue<std::shared_ptr<PipelineData>> max_clique_queue;
-    std::queue<std::shared_ptr<PipelineData>> response_queue;
+    // One algorithm stage of the fan-out: what it computes and its input
+    // queue. The request is owned jointly by the stages it was fanned out
+    // to, so they get plain pointers and the last one to finish reclaims it.
+    struct AlgorithmStage {
+        const char* title;                      // Section heading in the response
+        graph::AlgorithmFactory::Problem problem;
+        graph::RingBuffer<PipelineData*> queue{QUEUE_CAPACITY};
+        
+        AlgorithmStage(const char* title, graph::AlgorithmFactory::Problem problem) : title(title), problem(problem) {}
+    };
     
-    // Mutexes for each queue
-    std::mutex request_mutex, mst_mutex, scc_mutex, max_flow_mutex, max_clique_mutex, response_mutex;
+    // Lock-free queues for the request handlers and the response sender;
+    // whoever holds the unique_ptr owns the request
+    graph::RingBuffer<std::unique_ptr<PipelineData>> request_queue{QUEUE_CAPACITY};
+    graph::RingBuffer<std::unique_ptr<PipelineData>> response_queue{QUEUE_CAPACITY};
     
-    // Condition variables for each queue
-    std::condition_variable request_cv, mst_cv, scc_cv, max_flow_cv, max_clique_cv, response_cv;
+    // Algorithm stages, in the order their sections appear in the response
+    AlgorithmStage algorithm_stages[ALGORITHM_STAGES] = {
+        {"MST WEIGHT", graph::AlgorithmFactory::Problem::SPANNING_TREE},
+        {"SCC", graph::AlgorithmFactory::Problem::SCC},
+        {"MAX FLOW", graph::AlgorithmFactory::Problem::MAX_FLOW},
+        {"MAX CLIQUE", graph::AlgorithmFactory::Problem::MAX_CLIQUE},
+    };
     
-    // Active objects (threads) for each pipeline stage
+    // Active objects (threads) for each pipeline stage; after the
+    // constructor only the autoscaler adds to them
     std::vector<std::thread> pipeline_threads;
+    std::thread autoscale_thread;
+    PipelineConfig config;
+    StageLoad loads[PIPELINE_STAGES];
+    ResponseSink respond;
     
     // Statistics
     std::atomic<int> total_requests{0};
     std::atomic<int> completed_requests{0};
+    std::atomic<bool> shut_down{false};
     
 public:
-    PipelineServer() {
+    PipelineServer(const PipelineConfig& config, ResponseSink respond) : config(config), respond(std::move(respond)) {
         std::cout << "Creating Pipeline Server with " << PIPELINE_STAGES << " stages\n";
         
-        // Create active objects for each pipeline stage
-        // Multiple request handlers for true concurrency
-        pipeline_threads.emplace_back(&PipelineServer::requestHandler, this, 0);
-        pipeline_threads.emplace_back(&PipelineServer::requestHandler, this, 0); // Second request handler
-        pipeline_threads.emplace_back(&PipelineServer::requestHandler, this, 0); // Third request handler
-        
-        pipeline_threads.emplace_back(&PipelineServer::mstProcessor, this, 1);
-        pipeline_threads.emplace_back(&PipelineServer::sccProcessor, this, 2);
-        pipeline_threads.emplace_back(&PipelineServer::maxFlowProcessor, this, 3);
-        pipeline_threads.emplace_back(&PipelineServer::maxCliqueProcessor, this, 4);
-        pipeline_threads.emplace_back(&PipelineServer::responseSender, this, 5);
+        // Create active objects for each pipeline stage; every stage can
+        // have several workers since they all pull from a shared queue
+        for (int stage_id = 0; stage_id < PIPELINE_STAGES; stage_id++) {
+            for (unsigned int i = 0; i < config.workers[stage_id]; i++) {
+                spawnWorker(stage_id);
+            }
+        }
         
         std::cout << "Pipeline stages created:\n";
-        std::cout << "  0: Request Handler (3 threads for concurrency)\n";
-        std::cout << "  1: MST Weight Processor\n";
-        std::cout << "  2: SCC Processor\n";
-        std::cout << "  3: Max Flow Processor\n";
-        std::cout << "  4: Max Clique Processor\n";
-        std::cout << "  5: Response Sender\n";
+        std::cout << "  0: Request Handler (" << config.workers[0] << " threads)\n";
+        std::cout << "  1: MST Weight Processor (" << config.workers[1] << " threads)  \\\n";
+        std::cout << "  2: SCC Processor (" << config.workers[2] << " threads)          | fan-out, run concurrently\n";
+        std::cout << "  3: Max Flow Processor (" << config.workers[3] << " threads)     |\n";
+        std::cout << "  4: Max Clique Processor (" << config.workers[4] << " threads)  /\n";
+        std::cout << "  5: Response Sender (" << config.workers[5] << " threads, joins the four results)\n";
+        
+        if (config.autoscale_max > 0) {
+            std::cout << "Autoscaling busy stages up to " << config.autoscale_max << " threads each\n";
+            autoscale_thread = std::thread(&PipelineServer::autoscaler, this);
+        }
     }
     
     ~PipelineServer() {
         shutdown();
     }
     
-    // Add new connection to the pipeline
-    void addConnection(int client_fd, const std::string& client_ip) {
-        // Create a connection handler that will read requests with timeout
-        std::thread([this, client_fd, client_ip]() {
-            this->handleConnection(client_fd, client_ip);
-        }).detach();
-    }
-    
-    // Add new request to the pipeline
+    // Add new request to the pipeline. Runs on the I/O engine thread, so it
+    // must never block: with the handlers a full queue behind, the client
+    // is turned away at once instead of stalling every other connection.
     void addRequest(int client_fd, const std::string& client_ip, const std::string& request) {
-        auto data = std::make_shared<PipelineData>(client_fd, client_ip, request);
+        auto data = std::make_unique<PipelineData>(client_fd, client_ip, request);
         total_requests++;
         
-        {
-            std::lock_guard<std::mutex> lock(request_mutex);
-            request_queue.push(data);
-            std::cout << "Request added to pipeline. Queue size: " << request_queue.size() 
-                      << ", Total requests: " << total_requests << " from " << client_ip << std::endl;
+        if (!request_queue.tryPush(data)) {
+            std::cout << "Request queue full, rejecting request from " << client_ip << std::endl;
+            respond(client_fd, "ERROR: Server busy, try again later");
+            return;
         }
-        request_cv.notify_all(); // Wake up ALL waiting request handlers
+        std::cout << "Request added to pipeline. Queue size: " << request_queue.size() 
+                  << ", Total requests: " << total_requests << " from " << client_ip << std::endl;
     }
     
-    // Shutdown the pipeline
+    // Shutdown the pipeline; later calls, such as the destructor's after an
+    // explicit shutdown, do nothing
     void shutdown() {
+        if (shut_down.exchange(true)) {
+            return;
+        }
         std::cout << "Shutting down Pipeline Server...\n";
         running = 0;
         
-        // Wake up all waiting threads
-        request_cv.notify_all();
-        mst_cv.notify_all();
-        scc_cv.notify_all();
-        max_flow_cv.notify_all();
-        max_clique_cv.notify_all();
-        response_cv.notify_all();
+        // No more workers once the autoscaler is gone
+        if (autoscale_thread.joinable()) {
+            autoscale_thread.join();
+        }
+        
+        // Fail every blocked push and pop, which stops the stage threads
+        request_queue.close();
+        for (AlgorithmStage& stage : algorithm_stages) {
+            stage.queue.close();
+        }
+        response_queue.close();
         
         // Join all pipeline threads
         for (auto& thread : pipeline_threads) {
@@ -202,6 +332,14 @@ public:
                 thread.join();
             }
         }
+        
+        // Release requests that were still in flight
+        PipelineData* pending;
+        for (AlgorithmStage& stage : algorithm_stages) {
+            while (stage.queue.tryPop(pending)) {
+                finishStage(pending);
+            }
+        }
         std::cout << "All pipeline threads finished\n";
     }
     
@@ -211,81 +349,90 @@ public:
         std::cout << "Total requests: " << total_requests << "\n";
         std::cout << "Completed requests: " << completed_requests << "\n";
         std::cout << "Pending requests: " << (total_requests - completed_requests) << "\n";
+        for (int stage_id = 0; stage_id < PIPELINE_STAGES; stage_id++) {
+            std::cout << "Stage " << STAGE_NAMES[stage_id] << ": " << loads[stage_id].workers << " workers, queue depth "
+                      << queueDepth(stage_id) << "\n";
+        }
         std::cout << "==========================\n\n";
     }
     
-    // Handle individual connection with timeout
-    void handleConnection(int client_fd, const std::string& client_ip) {
-        std::cout << "Connection handler started for " << client_ip << std::endl;
-        
-        // Use select to wait for data with timeout
-        fd_set readfds;
-        FD_ZERO(&readfds);
-        FD_SET(client_fd, &readfds);
-        
-        struct timeval tv;
-        tv.tv_sec = 30;  // 30 second timeout
-        tv.tv_usec = 0;
-        
-        int activity = select(client_fd + 1, &readfds, NULL, NULL, &tv);
-        
-        if (activity < 0) {
-            perror("select in connection handler");
-            close(client_fd);
-            return;
+private:
+    // Start one more worker thread for a stage
+    void spawnWorker(int stage_id) {
+        loads[stage_id].workers++;
+        if (stage_id == 0) {
+            pipeline_threads.emplace_back(&PipelineServer::requestHandler, this, stage_id);
+        } else if (stage_id == PIPELINE_STAGES - 1) {
+            pipeline_threads.emplace_back(&PipelineServer::responseSender, this, stage_id);
+        } else {
+            pipeline_threads.emplace_back(&PipelineServer::algorithmProcessor, this, stage_id, static_cast<size_t>(stage_id - 1));
         }
-        
-        if (activity == 0) {
-            // Timeout - no data received
-            std::cout << "Timeout waiting for request from " << client_ip << std::endl;
-            close(client_fd);
-            return;
+    }
+    
+    // Threads one parallel engine call may use. The request handlers and the
+    // four fanned-out algorithm stages can all be busy at once, so the cores
+    // are split evenly between their workers instead of each asking for all.
+    // Counts the current workers, so the share shrinks as the autoscaler
+    // adds threads.
+    unsigned int threadShare() const {
+        unsigned int computing = 0;
+        for (int stage_id = 0; stage_id < PIPELINE_STAGES - 1; stage_id++) {
+            computing += loads[stage_id].workers.load(std::memory_order_relaxed);
         }
-        
-        // Data is available, read the request
-        char buffer[1024];
-        ssize_t bytes_received = recv(client_fd, buffer, sizeof(buffer) - 1, 0);
-        
-        if (bytes_received > 0) {
-            buffer[bytes_received] = '\0';
-            std::string request(buffer);
-            
-            std::cout << "Received request from " << client_ip << ": " << request << std::endl;
+        return std::max(1u, std::thread::hardware_concurrency() / std::max(1u, computing));
+    }
+    
+    // Requests waiting in a stage's input queue
+    size_t queueDepth(int stage_id) const {
+        if (stage_id == 0) return request_queue.size();
+        if (stage_id == PIPELINE_STAGES - 1) return response_queue.size();
+        return algorithm_stages[stage_id - 1].queue.size();
+    }
+    
+    // Every interval, give a stage another worker when at least one request
+    // per worker is waiting and its workers spent most of the interval
+    // serving requests: the backlog is then the stage's own service time,
+    // not a slow producer. Surplus workers are not retired - an idle one
+    // sleeps on its queue's futex and costs no CPU.
+    void autoscaler() {
+        auto last = std::chrono::steady_clock::now();
+        while (running) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(AUTOSCALE_INTERVAL_MS));
+            auto now = std::chrono::steady_clock::now();
+            double interval = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count());
+            last = now;
             
-            // Add request to pipeline
-            addRequest(client_fd, client_ip, request);
-        } else {
-            // Error reading request
-            std::cout << "Error reading request from " << client_ip << std::endl;
-            close(client_fd);
+            for (int stage_id = 0; stage_id < PIPELINE_STAGES && running; stage_id++) {
+                StageLoad& load = loads[stage_id];
+                unsigned int workers = load.workers;
+                double utilization = static_cast<double>(load.busy_ns.exchange(0)) / (interval * workers);
+                size_t depth = queueDepth(stage_id);
+                if (workers < config.autoscale_max && depth >= workers && utilization > 0.75) {
+                    spawnWorker(stage_id);
+                    std::cout << "Autoscaler: stage " << STAGE_NAMES[stage_id] << " grew to " << workers + 1
+                              << " workers (queue depth " << depth << ", " << static_cast<int>(utilization * 100)
+                              << "% busy)" << std::endl;
+                }
+            }
         }
     }
     
-private:
     // Stage 0: Request Handler - Parses requests and generates graphs
     void requestHandler(int stage_id) {
         std::cout << "Stage " << stage_id << " (Request Handler) started\n";
         
-        while (running) {
-            std::shared_ptr<PipelineData> data;
-            
-            {
-                std::unique_lock<std::mutex> lock(request_mutex);
-                request_cv.wait(lock, [this] { return !request_queue.empty() || !running; });
-                
-                if (!running) break;
-                
-                data = request_queue.front();
-                request_queue.pop();
-                std::cout << "Thread " << std::this_thread::get_id() << " picked up request from " 
-                          << data->client_ip << " (queue size now: " << request_queue.size() << ")" << std::endl;
-            }
+        std::unique_ptr<PipelineData> data;
+        while (request_queue.pop(data)) {
+            BusyTimer timer(loads[stage_id]);
+            std::cout << "Thread " << std::this_thread::get_id() << " picked up request from " 
+                      << data->client_ip << " (queue size now: " << request_queue.size() << ")" << std::endl;
             
             std::cout << "Stage " << stage_id << " (Thread " << std::this_thread::get_id() << ") processing request from " << data->client_ip << std::endl;
             
             try {
                 // Parse request parameters - FAST parsing
-                int edges = -1, vertices = -1, seed = -1;
+                int edges = -1, vertices = -1, seed = -1, budget = 0;
+                bool directed = false;
                 std::string algorithm = "EULER";
                 
                 // Use faster string parsing
@@ -295,69 +442,72 @@ private:
                     if (token == "-e" && iss >> edges) continue;
                     if (token == "-v" && iss >> vertices) continue;
                     if (token == "-s" && iss >> seed) continue;
+                    if (token == "-d") {
+                        directed = true;
+                        continue;
+                    }
+                    if (token == "-t") {
+                        if (!(iss >> budget) || budget <= 0) {
+                            budget = -1;
+                        }
+                        continue;
+                    }
                     if (token == "-a" && iss >> algorithm) {
                         algorithm = trim(algorithm); // Trim any whitespace/newlines
-                        break;
+                        continue;
                     }
                 }
                 
-                if (edges < 0 || vertices <= 0) {
-                    data->result = "ERROR: Invalid parameters";
+                if (edges < 0 || vertices <= 0 || budget < 0) {
                     // Send error response directly
-                    if (send(data->client_fd, data->result.c_str(), data->result.length(), 0) < 0) {
-                        perror("send");
-                    }
-                    close(data->client_fd);
+                    respond(data->client_fd, "ERROR: Invalid parameters");
                     completed_requests++;
                     continue;
                 }
                 
+                // The budget covers everything from here to the last stage
+                data->budget_ms = budget;
+                data->cancel = budget > 0 ? std::make_unique<graph::CancellationToken>(std::chrono::milliseconds(budget))
+                                          : std::make_unique<graph::CancellationToken>();
+                
                 // Generate graph - this is the heavy operation
-                data->graph = std::make_unique<graph::Graph>(graph::Graph::generateRandomGraph(vertices, edges, seed));
+                unsigned int threads = threadShare();
+                data->graph = graph::Graph::createRandomGraph(vertices, edges, seed, threads, directed);
+                data->csr = std::make_unique<graph::CSRGraph>(*data->graph);
                 data->algorithm = algorithm;
+                data->vertices = vertices;
+                data->edges = edges;
+                data->seed = seed;
+                data->directed = directed;
                 
                 std::cout << "Stage " << stage_id << " generated graph with " << vertices << " vertices, " << edges << " edges\n";
                 
                 // TRUE PIPELINE: Every request goes through ALL algorithm stages
                 std::cout << "Stage " << stage_id << " starting pipeline processing for " << data->client_ip << std::endl;
                 
-                // Add Euler circuit analysis to the result
-                std::string euler_result = "";
-                if (data->graph->hasEulerCircuit()) {
-                    std::vector<int> circuit = data->graph->findEulerCircuit();
-                    euler_result = "EULER CIRCUIT: SUCCESS!\n";
-                    euler_result += "Circuit: ";
-                    for (size_t i = 0; i < circuit.size(); ++i) {
-                        if (i > 0) euler_result += " -> ";
-                        euler_result += std::to_string(circuit[i]);
-                    }
-                    euler_result += "\n";
-                } else {
-                    euler_result = "EULER CIRCUIT: NOT POSSIBLE\n";
-                    euler_result += "Reason: Graph is not connected or has odd-degree vertices\n";
+                // Euler circuit analysis; formatted with the other results at the end
+                data->has_euler_circuit = data->graph->hasEulerCircuit(threads);
+                if (data->has_euler_circuit) {
+                    data->euler_circuit = data->graph->findEulerCircuit(threads);
                 }
                 
-                // Store Euler result and send to MST processor (first stage)
-                data->result = "GRAPH ANALYSIS RESULTS:\n";
-                data->result += "Vertices: " + std::to_string(vertices) + "\n";
-                data->result += "Edges: " + std::to_string(edges) + "\n";
-                data->result += "Seed: " + std::to_string(seed) + "\n\n";
-                data->result += euler_result + "\n";
-                
-                std::cout << "  → Sending to MST processor (queue size: " << mst_queue.size() << ")" << std::endl;
-                {
-                    std::lock_guard<std::mutex> lock(mst_mutex);
-                    mst_queue.push(data);
-                    mst_cv.notify_one();
+                // Fan out: the algorithm stages only read the CSR snapshot,
+                // so all of them work on this request at once
+                data->stages.resize(ALGORITHM_STAGES);
+                data->pending_stages.store(ALGORITHM_STAGES, std::memory_order_relaxed);
+                std::cout << "  → Fanning out to " << ALGORITHM_STAGES << " algorithm stages" << std::endl;
+                timer.stop(); // Waiting on a full stage queue is not service time
+                PipelineData* shared = data.release();
+                for (AlgorithmStage& stage : algorithm_stages) {
+                    PipelineData* item = shared;
+                    if (!stage.queue.push(item)) {
+                        finishStage(shared); // Shutting down; drop this stage's share
+                    }
                 }
-                
+
             } catch (const std::exception& e) {
-                data->result = "ERROR: " + std::string(e.what());
                 // Send error response directly
-                if (send(data->client_fd, data->result.c_str(), data->result.length(), 0) < 0) {
-                    perror("send");
-                }
-                close(data->client_fd);
+                respond(data->client_fd, "ERROR: " + std::string(e.what()));
                 completed_requests++;
             }
         }
@@ -365,247 +515,80 @@ private:
         std::cout << "Stage " << stage_id << " (Request Handler) finished\n";
     }
     
-    // Stage 1: MST Weight Processor
-    void mstProcessor(int stage_id) {
-        std::cout << "Stage " << stage_id << " (MST Weight) started\n";
-        
-        while (running) {
-            std::shared_ptr<PipelineData> data;
-            
-            {
-                std::unique_lock<std::mutex> lock(mst_mutex);
-                mst_cv.wait(lock, [this] { return !mst_queue.empty() || !running; });
-                
-                if (!running) break;
-                
-                data = mst_queue.front();
-                mst_queue.pop();
-            }
-            
-            std::cout << "Stage " << stage_id << " processing MST request from " << data->client_ip << std::endl;
-            
-            try {
-                auto algo = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MST_WEIGHT);
-                if (algo) {
-                    data->result += "=== MST WEIGHT ALGORITHM ===\n";
-                    data->result += algo->getName() + "\n";
-                    data->result += "Result: " + algo->execute(*data->graph) + "\n\n";
-                    // Remove heavy analyzeGraph call to improve performance
-                } else {
-                    data->result += "ERROR: Failed to create MST algorithm instance\n\n";
-                }
-                
-                // Send to SCC processor (next stage)
-                std::cout << "Stage " << stage_id << " sending to SCC processor (queue size: " << scc_queue.size() << ")" << std::endl;
-                {
-                    std::lock_guard<std::mutex> lock(scc_mutex);
-                    scc_queue.push(data);
-                    scc_cv.notify_one();
-                }
-                
-            } catch (const std::exception& e) {
-                data->result += "ERROR: " + std::string(e.what()) + "\n\n";
-                // Continue to next stage anyway
-                {
-                    std::lock_guard<std::mutex> lock(scc_mutex);
-                    scc_queue.push(data);
-                    scc_cv.notify_one();
-                }
-            }
+    // Run the engine for `problem` - the one the request named if it solves
+    // it, else the registry's preferred one - and keep its typed result.
+    // workspace belongs to the calling stage thread. Once the request's time
+    // budget has run out the stage is skipped, so one slow request cannot
+    // hold up the requests queued behind it. Each stage writes only its own
+    // slot of data.stages, so the fanned-out stages never share a result.
+    void runStage(PipelineData& data, size_t slot, graph::Workspace& workspace) const {
+        const AlgorithmStage& stage = algorithm_stages[slot];
+        auto type = graph::AlgorithmFactory::select(stage.problem, data.algorithm);
+        if (data.cancel->expired()) {
+            data.stages[slot] = {stage.title, graph::AlgorithmFactory::info(type).title,
+                                 graph::NoticeResult{"Skipped: time budget exceeded"}, ""};
+            return;
         }
-        
-        std::cout << "Stage " << stage_id << " (MST Weight) finished\n";
+        graph::AlgorithmResult result = graph::AlgorithmFactory::run(type, *data.csr, workspace, *data.cancel, threadShare());
+        data.stages[slot] = {stage.title, graph::AlgorithmFactory::info(type).title, std::move(result), ""};
     }
     
-    // Stage 2: SCC Processor
-    void sccProcessor(int stage_id) {
-        std::cout << "Stage " << stage_id << " (SCC) started\n";
-        
-        while (running) {
-            std::shared_ptr<PipelineData> data;
-            
-            {
-                std::unique_lock<std::mutex> lock(scc_mutex);
-                scc_cv.wait(lock, [this] { return !scc_queue.empty() || !running; });
-                
-                if (!running) break;
-                
-                data = scc_queue.front();
-                scc_queue.pop();
-            }
-            
-            std::cout << "Stage " << stage_id << " processing SCC request from " << data->client_ip << std::endl;
-            
-            try {
-                auto algo = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::SCC);
-                if (algo) {
-                    data->result += "=== SCC ALGORITHM ===\n";
-                    data->result += algo->getName() + "\n";
-                    data->result += "Result: " + algo->execute(*data->graph) + "\n\n";
-                    // Remove heavy analyzeGraph call to improve performance
-                } else {
-                    data->result += "ERROR: Failed to create SCC algorithm instance\n\n";
-                }
-                
-                // Send to Max Flow processor (next stage)
-                std::cout << "Stage " << stage_id << " sending to Max Flow processor (queue size: " << max_flow_queue.size() << ")" << std::endl;
-                {
-                    std::lock_guard<std::mutex> lock(max_flow_mutex);
-                    max_flow_queue.push(data);
-                    max_flow_cv.notify_one();
-                }
-                
-            } catch (const std::exception& e) {
-                data->result += "ERROR: " + std::string(e.what()) + "\n\n";
-                // Continue to next stage anyway
-                {
-                    std::lock_guard<std::mutex> lock(max_flow_mutex);
-                    max_flow_queue.push(data);
-                    max_flow_cv.notify_one();
-                }
-            }
+    // Drop one stage's share of a fanned-out request; the last share joins
+    // the results and hands the request to the response sender
+    void finishStage(PipelineData* data) {
+        if (data->pending_stages.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
         }
-        
-        std::cout << "Stage " << stage_id << " (SCC) finished\n";
+        std::unique_ptr<PipelineData> joined(data);
+        response_queue.push(joined); // Fails only once shut down; the front end closes the socket
     }
     
-    // Stage 3: Max Flow Processor
-    void maxFlowProcessor(int stage_id) {
-        std::cout << "Stage " << stage_id << " (Max Flow) started\n";
+    // Stages 1-4: Algorithm Processor - runs one stage of the fan-out on
+    // every request, then the last stage to finish hands it to the sender
+    void algorithmProcessor(int stage_id, size_t slot) {
+        AlgorithmStage& stage = algorithm_stages[slot];
+        std::cout << "Stage " << stage_id << " (" << stage.title << ") started\n";
+        graph::Workspace workspace; // Scratch arrays reused across requests
         
-        while (running) {
-            std::shared_ptr<PipelineData> data;
+        PipelineData* data;
+        while (stage.queue.pop(data)) {
+            std::cout << "Stage " << stage_id << " processing " << stage.title << " request from " << data->client_ip << std::endl;
             
             {
-                std::unique_lock<std::mutex> lock(max_flow_mutex);
-                max_flow_cv.wait(lock, [this] { return !max_flow_queue.empty() || !running; });
-                
-                if (!running) break;
-                
-                data = max_flow_queue.front();
-                max_flow_queue.pop();
-            }
-            
-            std::cout << "Stage " << stage_id << " processing Max Flow request from " << data->client_ip << std::endl;
-            
-            try {
-                auto algo = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MAX_FLOW);
-                if (algo) {
-                    data->result += "=== MAX FLOW ALGORITHM ===\n";
-                    data->result += algo->getName() + "\n";
-                    data->result += "Result: " + algo->execute(*data->graph) + "\n\n";
-                    // Remove heavy analyzeGraph call to improve performance
-                } else {
-                    data->result += "ERROR: Failed to create Max Flow algorithm instance\n\n";
-                }
-                
-                // Send to Max Clique processor (next stage)
-                std::cout << "Stage " << stage_id << " sending to Max Clique processor (queue size: " << max_clique_queue.size() << ")" << std::endl;
-                {
-                    std::lock_guard<std::mutex> lock(max_clique_mutex);
-                    max_clique_queue.push(data);
-                    max_clique_cv.notify_one();
-                }
-                
-            } catch (const std::exception& e) {
-                data->result += "ERROR: " + std::string(e.what()) + "\n\n";
-                // Continue to next stage anyway
-                {
-                    std::lock_guard<std::mutex> lock(max_clique_mutex);
-                    max_clique_queue.push(data);
-                    max_clique_cv.notify_one();
+                BusyTimer timer(loads[stage_id]);
+                try {
+                    runStage(*data, slot, workspace);
+                } catch (const std::exception& e) {
+                    data->stages[slot] = {"", "", graph::NoticeResult{}, e.what()};
                 }
             }
-        }
-        
-        std::cout << "Stage " << stage_id << " (Max Flow) finished\n";
-    }
-    
-    // Stage 4: Max Clique Processor
-    void maxCliqueProcessor(int stage_id) {
-        std::cout << "Stage " << stage_id << " (Max Clique) started\n";
-        
-        while (running) {
-            std::shared_ptr<PipelineData> data;
-            
-            {
-                std::unique_lock<std::mutex> lock(max_clique_mutex);
-                max_clique_cv.wait(lock, [this] { return !max_clique_queue.empty() || !running; });
-                
-                if (!running) break;
-                
-                data = max_clique_queue.front();
-                max_clique_queue.pop();
-            }
-            
-            std::cout << "Stage " << stage_id << " processing Max Clique request from " << data->client_ip << std::endl;
             
-            try {
-                auto algo = graph::AlgorithmFactory::createAlgorithm(graph::AlgorithmFactory::AlgorithmType::MAX_CLIQUE);
-                if (algo) {
-                    data->result += "=== MAX CLIQUE ALGORITHM ===\n";
-                    data->result += algo->getName() + "\n";
-                    data->result += "Result: " + algo->execute(*data->graph) + "\n\n";
-                    // Remove heavy analyzeGraph call to improve performance
-                } else {
-                    data->result += "ERROR: Failed to create Max Clique algorithm instance\n\n";
-                }
-                
-                // Send to response stage (final stage)
-                std::cout << "Stage " << stage_id << " sending to response stage (queue size: " << response_queue.size() << ")" << std::endl;
-                {
-                    std::lock_guard<std::mutex> lock(response_mutex);
-                    response_queue.push(data);
-                    response_cv.notify_one();
-                }
-                
-            } catch (const std::exception& e) {
-                data->result += "ERROR: " + std::string(e.what()) + "\n\n";
-                // Send to response stage anyway
-                {
-                    std::lock_guard<std::mutex> lock(response_mutex);
-                    response_queue.push(data);
-                    response_cv.notify_one();
-                }
-            }
+            // Join: the other stages have written their slots by the time
+            // the count reaches zero
+            finishStage(data);
         }
         
-        std::cout << "Stage " << stage_id << " (Max Clique) finished\n";
+        std::cout << "Stage " << stage_id << " (" << stage.title << ") finished\n";
     }
     
     // Stage 5: Response Sender
     void responseSender(int stage_id) {
         std::cout << "Stage " << stage_id << " (Response Sender) started\n";
         
-        while (running) {
-            std::shared_ptr<PipelineData> data;
-            
-            {
-                std::unique_lock<std::mutex> lock(response_mutex);
-                response_cv.wait(lock, [this] { return !response_queue.empty() || !running; });
-                
-                if (!running) break;
-                
-                data = response_queue.front();
-                response_queue.pop();
-            }
-            
+        std::unique_ptr<PipelineData> data;
+        while (response_queue.pop(data)) {
+            BusyTimer timer(loads[stage_id]);
             std::cout << "Stage " << stage_id << " sending response to " << data->client_ip << std::endl;
             
             // Calculate processing time
             auto end_time = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - data->start_time);
             
-            // Add timing information to response
-            std::string full_response = data->result + "\n\nPipeline processing time: " + std::to_string(duration.count()) + " microseconds\n";
-            
-            // Send response to client
-            if (send(data->client_fd, full_response.c_str(), full_response.length(), 0) < 0) {
-                perror("send");
-            }
+            // Serialize the typed stage results, with timing information
+            std::string full_response = formatResponse(*data, duration.count());
             
-            // Close connection
-            close(data->client_fd);
+            // The front end writes it without blocking, then closes the connection
+            respond(data->client_fd, std::move(full_response));
             completed_requests++;
             
             std::cout << "Stage " << stage_id << " completed response for " << data->client_ip 
@@ -622,19 +605,59 @@ std::unique_ptr<PipelineServer> pipeline_server;
 // Signal handler for graceful shutdown
 void signal_handler(int sig)
 {
+    // The I/O engine loop notices within 100 ms; main shuts the pipeline down
     running = 0;
     std::cout << "\nReceived signal " << sig << ", shutting down server" << std::endl;
-    
-    // Shutdown pipeline server
-    if (pipeline_server) {
-        pipeline_server->shutdown();
+}
+
+// Worker count in 1..MAX_STAGE_WORKERS
+bool parseWorkerCount(const std::string& text, unsigned int& count)
+{
+    char* end = nullptr;
+    long value = strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || value < 1 || value > MAX_STAGE_WORKERS)
+    {
+        return false;
     }
+    count = static_cast<unsigned int>(value);
+    return true;
+}
 
-    if (listen_socket_fd != -1)
+// Options after the port: -w <stage>=<threads>, repeatable, -A <max threads>
+// and -i <epoll|uring>
+bool parsePipelineOptions(int argc, char *argv[], PipelineConfig& config)
+{
+    for (int i = 2; i < argc; i += 2)
     {
-        close(listen_socket_fd);
-        listen_socket_fd = -1;
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+        std::string option = argv[i];
+        std::string value = argv[i + 1];
+        if (option == "-A")
+        {
+            if (!parseWorkerCount(value, config.autoscale_max)) return false;
+            continue;
+        }
+        if (option == "-i")
+        {
+            if (!graph::parseBackend(value, config.backend)) return false;
+            continue;
+        }
+        size_t eq = value.find('=');
+        if (option != "-w" || eq == std::string::npos)
+        {
+            return false;
+        }
+        auto name = std::find(std::begin(STAGE_NAMES), std::end(STAGE_NAMES), value.substr(0, eq));
+        if (name == std::end(STAGE_NAMES) ||
+            !parseWorkerCount(value.substr(eq + 1), config.workers[name - std::begin(STAGE_NAMES)]))
+        {
+            return false;
+        }
     }
+    return true;
 }
 
 int main(int argc, char *argv[])
@@ -643,11 +666,13 @@ int main(int argc, char *argv[])
 
     // TCP Server setup
     int tcp_port;
+    PipelineConfig config;
 
-    if (argc != 2)
+    if (argc < 2 || !parsePipelineOptions(argc, argv, config))
     {
-        std::cerr << "Error: Number of parameters is incorrect\n";
-        std::cerr << "Usage: " << argv[0] << " <port>\n";
+        std::cerr << "Error: Invalid parameters\n";
+        std::cerr << "Usage: " << argv[0] << " <port> [-w <stage>=<threads>]... [-A <max threads per stage>] [-i <epoll|uring>]\n";
+        std::cerr << "Stages: REQUEST, MST, SCC, MAX_FLOW, MAX_CLIQUE, RESPONSE\n";
         return 1;
     }
     else
@@ -669,8 +694,6 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    listen_socket_fd = listen_fd;
-
     // Set socket options
     int opt = 1;
     setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
@@ -699,64 +722,37 @@ int main(int argc, char *argv[])
     std::cout << "Pipeline stages: " << PIPELINE_STAGES << std::endl;
     std::cout << "Waiting for connections..." << std::endl;
 
-    // Initialize Pipeline server
-    pipeline_server = std::make_unique<PipelineServer>();
-
-    // Main accept loop
-    while (running)
+    try
     {
-        // Use select to check for incoming connections with timeout
-        fd_set readfds;
-        FD_ZERO(&readfds);
-        FD_SET(listen_fd, &readfds);
-
-        struct timeval tv;
-        tv.tv_sec = 0;
-        tv.tv_usec = 100000; // 100ms timeout
-
-        int activity = select(listen_fd + 1, &readfds, NULL, NULL, &tv);
-
-        if (activity < 0)
-        {
-            if (running) perror("select");
-            continue;
-        }
-
-        if (!running)
-        {
-            break;
-        }
-
-        // Check if there's a new connection ready
-        if (activity == 0 || !FD_ISSET(listen_fd, &readfds))
-        {
-            continue;
-        }
-
-        // Accept new connection
-        struct sockaddr_in client_addr;
-        socklen_t client_len = sizeof(client_addr);
-        int client_fd = accept(listen_fd, (struct sockaddr *)&client_addr, &client_len);
+        // One I/O engine thread does all socket I/O; the pipeline only sees
+        // complete requests and hands back complete responses
+        auto engine = graph::IoEngine::create(config.backend, listen_fd, [](int client_fd, const std::string& client_ip, std::string request) {
+            pipeline_server->addRequest(client_fd, client_ip, request);
+            
+            // Print statistics periodically
+            static int request_count = 0;
+            if (++request_count % 10 == 0) {
+                pipeline_server->printStats();
+            }
+        });
         
-        if (client_fd < 0)
-        {
-            perror("accept");
-            continue;
-        }
-
-        char client_ip[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &client_addr.sin_addr, client_ip, INET_ADDRSTRLEN);
-        std::cout << "New connection from " << client_ip << ":" << ntohs(client_addr.sin_port) << std::endl;
-
-        // Add connection to pipeline without waiting for request
-        // The pipeline will handle reading the request when ready
-        pipeline_server->addConnection(client_fd, client_ip);
+        // Initialize Pipeline server
+        pipeline_server = std::make_unique<PipelineServer>(config, [&engine](int client_fd, std::string response) {
+            engine->respond(client_fd, std::move(response));
+        });
         
-        // Print statistics periodically
-        static int connection_count = 0;
-        if (++connection_count % 10 == 0) {
-            pipeline_server->printStats();
-        }
+        std::cout << "I/O engine: " << engine->name() << std::endl;
+        engine->run(running);
+        
+        // Stop the stages before the engine they respond through
+        pipeline_server->shutdown();
+        pipeline_server.reset();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        close(listen_fd);
+        return 1;
     }
 
     close(listen_fd);
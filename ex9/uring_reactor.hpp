@@ -0,0 +1,116 @@
+#pragma once
+#include "io_engine.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <linux/io_uring.h>
+
+namespace graph {
+
+// io_uring front end, driven through the raw syscalls.
+// One multishot accept yields every connection, reads land in buffers the
+// kernel picks from a provided-buffer group, and each response goes out
+// as a send linked to the close of its socket. Everything a loop iteration
+// queues is submitted by the same io_uring_enter that waits for the next
+// completions, so under load a request costs well under one syscall.
+// The constructor probes the kernel for every operation used and throws
+// when one is missing, so IoEngine::create can fall back to epoll.
+class UringReactor final : public IoEngine {
+public:
+    static constexpr unsigned int RING_ENTRIES = 256;
+    static constexpr unsigned int BUFFER_COUNT = 256;
+    static constexpr unsigned int BUFFER_SIZE = 4096;
+    // Connections that send no complete request within this are closed
+    static constexpr std::chrono::seconds REQUEST_TIMEOUT{30};
+
+    // listen_fd must already be listening; throws std::runtime_error when
+    // the ring cannot be set up or lacks an operation this engine uses
+    UringReactor(int listen_fd, RequestHandler onRequest);
+    ~UringReactor() override;
+
+    UringReactor(const UringReactor&) = delete;
+    UringReactor& operator=(const UringReactor&) = delete;
+
+    void run(const volatile sig_atomic_t& running) override;
+    void respond(int client_fd, std::string response) override;
+    const char* name() const override { return "io_uring"; }
+
+private:
+    // Operation kinds, kept in the upper half of user_data
+    enum class Op : uint32_t { ACCEPT = 1, RECV, SEND, CLOSE, WAKE, PROVIDE, CANCEL };
+    enum class State { READING, WAITING, WRITING };
+
+    struct Connection {
+        std::string ip;
+        std::string buffer;   // Request bytes while reading, response bytes while writing
+        size_t sent = 0;
+        bool sendFailed = false;
+        State state = State::READING;
+        std::chrono::steady_clock::time_point opened;
+    };
+
+    static uint64_t tag(Op op, int fd) { return (static_cast<uint64_t>(op) << 32) | static_cast<uint32_t>(fd); }
+
+    void probe();
+    void drain();
+    void release();
+    io_uring_sqe* nextSqe();
+    void reserve(unsigned int count);
+    void enter(bool wait);
+    void reap();
+
+    void armAccept();
+    void armRecv(int fd);
+    void armWake();
+    void sendAndClose(int fd, Connection& conn);
+    void closeFd(int fd);
+
+    void accepted(int res, unsigned int flags);
+    void received(int fd, int res, unsigned int flags);
+    void sent(int fd, int res);
+    void closed(int fd, int res);
+    void provideBuffers(unsigned int first, unsigned int count);
+    void flushResponses();
+    void expireIdle();
+
+    int listenFd;
+    int ringFd = -1;
+    int wakeFd = -1;      // eventfd that respond() pokes
+    RequestHandler onRequest;
+
+    // Shared rings and the kernel's view of them
+    void* ringMemory = nullptr;
+    size_t ringSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqesSize = 0;
+    unsigned int* sqHead = nullptr;
+    unsigned int* sqTail = nullptr;
+    unsigned int* sqArray = nullptr;
+    unsigned int sqMask = 0;
+    unsigned int sqEntries = 0;
+    unsigned int localTail = 0;    // Filled entries, published by enter()
+    unsigned int toSubmit = 0;
+    unsigned int inFlight = 0;     // Requests the kernel has not finished
+    bool draining = false;         // Completions are only counted, not handled
+    unsigned int* cqHead = nullptr;
+    unsigned int* cqTail = nullptr;
+    unsigned int cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    // Provided buffers for recv, BUFFER_COUNT slices of BUFFER_SIZE
+    std::unique_ptr<char[]> bufferPool;
+
+    uint64_t wakeValue = 0;        // Target of the pending eventfd read
+    std::unordered_map<int, Connection> connections;
+    std::chrono::steady_clock::time_point lastSweep;
+
+    std::mutex responseMutex;
+    std::vector<std::pair<int, std::string>> responses;   // Handed over by respond()
+};
+
+} // namespace graph
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace graph {
+
+// Fork-join pool for independent tasks of very uneven cost.
+// Tasks 0..count-1 are dealt round-robin onto per-worker deques. A worker
+// runs its own tasks front to back, in submission order, and once its deque
+// is empty steals from the back of the others, so a few expensive tasks
+// cannot leave the remaining threads idle.
+// The helper threads are started once per process and shared by every
+// pool, so a pool is cheap to build and run() never spawns threads. A run
+// with a single worker or a single task stays on the calling thread.
+class WorkStealingPool {
+public:
+    // threads == 0 uses every hardware thread
+    explicit WorkStealingPool(unsigned int threads);
+
+    unsigned int size() const;
+    // Run body(task, worker) for every task; returns when all have finished.
+    // worker < size() identifies the calling thread for per-thread state.
+    // Safe to call from several threads at once, and from inside a task.
+    void run(size_t count, const std::function<void(size_t, unsigned int)>& body);
+
+private:
+    struct Job;
+    class Helpers;
+
+    unsigned int workers;
+};
+
+} // namespace graph